@@ -39,6 +39,8 @@
 #include <stdio.h>
 #include <stdbool.h>
 
+#include "benchharness.h"
+
 #define CALC_PI 3.14159265358979323846
 
 static const double PI        = CALC_PI;
@@ -326,30 +328,15 @@ void radecdist(double state[2][3], double rdd[3])
 //---------------------------------------------------------------------------
 // Entry point
 // Calculate RA and Dec for noon on every day in 1900-2100
-int main(int argc, char ** argv)
+// what we're timing
+static void run_almabench(void * data)
 {
     int i, n, p;
     double jd[2];
     double pv[2][3];
     double position[3];
-    bool   ga_testing = false;
-    
-    // do we have verbose output?
-    if (argc > 1)
-    {
-        for (i = 1; i < argc; ++i)
-        {
-            if (!strcmp(argv[1],"-ga"))
-            {
-                ga_testing = true;
-                break;
-            }
-        }
-    }
-    
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
+    double sum = 0.0;
+    int days = bench_scaled(TEST_DAYS);
     
     // main loop
     for (i = 0; i < TEST_LOOPS; ++i)
@@ -357,7 +344,7 @@ int main(int argc, char ** argv)
         jd[0] = J2000;
         jd[1] = 0.0;
 
-        for (n = 0; n < TEST_DAYS; ++n)
+        for (n = 0; n < days; ++n)
         {
             jd[0] += 1.0;
             
@@ -365,21 +352,16 @@ int main(int argc, char ** argv)
             {
                 planetpv(jd,p,pv);
                 radecdist(pv,position);
+                sum += position[0] + position[1] + position[2];
             }
         }
     }
 
-    // get final time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
+    bench_checksum(sum);
+}
 
-    // report runtime
-    if (ga_testing)
-        fprintf(stdout,"%f",run_time);
-    else        
-        fprintf(stdout,"\nalmabench (Std. C) run time: %f\n\n",run_time);
-    
-    fflush(stdout);
-    
-    return 0;
+int main(int argc, char ** argv)
+{
+    bench_options options = bench_parse("almabench",argc,argv);
+    return bench_run(&options,run_almabench,NULL,NULL);
 }
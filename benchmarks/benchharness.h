@@ -0,0 +1,292 @@
+/*
+    benchharness.h
+
+    No rights reserved. This is public domain software, for use by anyone.
+
+    Timing shared by the ACOVEA benchmarks. A benchmark supplies the code
+    being timed as a function, and optionally a function that restores its
+    data between runs; the harness handles the command line, warms up,
+    times repeated runs with a monotonic clock, and reports the results.
+
+    Command line:
+
+        -ga             report for ACOVEA (one machine-readable line)
+        -warmup n       untimed runs before timing (default BENCH_WARMUP)
+        -repeats n      timed runs (default BENCH_REPEATS)
+        -fork-server    serve runs to ACOVEA (see below)
+        -scale f        fraction of the full workload to run (default 1)
+
+    ACOVEA runs each benchmark with -ga alone, so a configuration that wants
+    repeated runs compiles them in, e.g. with -DBENCH_REPEATS=5.
+
+    A benchmark passes a checksum of what it computed to bench_checksum();
+    ACOVEA can compare it with the checksum of a baseline build, to reject
+    options that make a benchmark faster by computing the wrong answer.
+
+    A benchmark sizes its workload with bench_scaled(), so that -scale
+    trades accuracy for speed; work should be proportional to the scale.
+    ACOVEA screens option sets at a small scale before measuring the
+    best of them at full scale.
+
+    With -ga, the result is a single line that begins with the fastest run
+    time, which is what earlier versions of ACOVEA read, followed by
+    key=value fields:
+
+        0.512345 bench=huffbench min=0.512345 median=0.514001 mean=0.515 max=0.52 runs=5 warmup=1 scale=1 checksum=1234.5 samples=0.512345,...
+
+    Otherwise a human-readable summary is printed.
+
+    As a fork server, a benchmark initializes once, announces itself on
+    descriptor 199, and waits. For every 4-byte request read from
+    descriptor 198, it forks a copy of itself that runs and reports as
+    above, then writes the copy's 4-byte wait status to descriptor 199.
+    It exits when descriptor 198 closes. Without those descriptors, it
+    simply runs.
+*/
+
+#if !defined(BENCHHARNESS_H)
+#define BENCHHARNESS_H
+
+#include <time.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+// defaults, which can be set when compiling
+#if !defined(BENCH_WARMUP)
+#define BENCH_WARMUP 0
+#endif
+
+#if !defined(BENCH_REPEATS)
+#define BENCH_REPEATS 1
+#endif
+
+// code being timed, or code that prepares for a run
+typedef void (*bench_function)(void * data);
+
+// how a benchmark is run
+typedef struct
+{
+    const char * name;
+    bool         ga_testing;
+    int          warmup;
+    int          repeats;
+    bool         fork_server;
+    double       scale;
+} bench_options;
+
+// fraction of the full workload, for bench_scaled
+static double bench_scale = 1.0;
+
+// checksum of the last run, if the benchmark reports one
+static double bench_checksum_value = 0.0;
+static bool   bench_has_checksum   = false;
+
+// monotonic time, in seconds
+static double bench_now(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return (double)now.tv_sec + (double)now.tv_nsec / 1000000000.0;
+}
+
+// read the command line
+static bench_options bench_parse(const char * name, int argc, char ** argv)
+{
+    bench_options options;
+    int i;
+
+    options.name        = name;
+    options.ga_testing  = false;
+    options.warmup      = BENCH_WARMUP;
+    options.repeats     = BENCH_REPEATS;
+    options.fork_server = false;
+    options.scale       = 1.0;
+
+    for (i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i],"-ga"))
+            options.ga_testing = true;
+        else if (!strcmp(argv[i],"-warmup") && (i + 1 < argc))
+            options.warmup = atoi(argv[++i]);
+        else if (!strcmp(argv[i],"-repeats") && (i + 1 < argc))
+            options.repeats = atoi(argv[++i]);
+        else if (!strcmp(argv[i],"-fork-server"))
+            options.fork_server = true;
+        else if (!strcmp(argv[i],"-scale") && (i + 1 < argc))
+            options.scale = atof(argv[++i]);
+    }
+
+    if (options.warmup < 0)
+        options.warmup = 0;
+
+    if (options.repeats < 1)
+        options.repeats = 1;
+
+    if ((options.scale <= 0.0) || (options.scale > 1.0))
+        options.scale = 1.0;
+
+    bench_scale = options.scale;
+
+    return options;
+}
+
+// not every benchmark uses every helper
+#if defined(__GNUC__)
+#define BENCH_UNUSED __attribute__((unused))
+#else
+#define BENCH_UNUSED
+#endif
+
+// a workload size or count, scaled; never less than one
+static BENCH_UNUSED int bench_scaled(int n)
+{
+    int result = (int)(n * bench_scale + 0.5);
+    return (result < 1) ? 1 : result;
+}
+
+// record a checksum of what a run computed; call it at the end of every run
+static void bench_checksum(double value)
+{
+    bench_checksum_value = value;
+    bench_has_checksum   = true;
+}
+
+static int bench_compare(const void * a, const void * b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
+// report run times, which are sorted first
+static void bench_report(const bench_options * options, double * times)
+{
+    int    n = options->repeats;
+    int    i;
+    double sum = 0.0;
+    double median;
+
+    qsort(times,n,sizeof(double),bench_compare);
+
+    for (i = 0; i < n; ++i)
+        sum += times[i];
+
+    median = (n % 2) ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2.0;
+
+    if (options->ga_testing)
+    {
+        fprintf(stdout,"%f bench=%s min=%f median=%f mean=%f max=%f runs=%d warmup=%d scale=%g ",
+                times[0],options->name,times[0],median,sum / n,times[n - 1],n,options->warmup,options->scale);
+
+        if (bench_has_checksum)
+            fprintf(stdout,"checksum=%.17g ",bench_checksum_value);
+
+        fprintf(stdout,"samples=");
+
+        for (i = 0; i < n; ++i)
+            fprintf(stdout,(i > 0) ? ",%f" : "%f",times[i]);
+
+        fprintf(stdout,"\n");
+    }
+    else
+    {
+        fprintf(stdout,"\n%s (Std. C) run time: %f\n",options->name,times[0]);
+
+        if (n > 1)
+            fprintf(stdout,"    fastest of %d runs; median %f, slowest %f\n",n,median,times[n - 1]);
+
+        if (bench_has_checksum)
+            fprintf(stdout,"    checksum %.17g\n",bench_checksum_value);
+
+        fprintf(stdout,"\n");
+    }
+
+    fflush(stdout);
+}
+
+// warm-up runs, then timed runs; reset, if given, is called before every
+// run and is not timed
+static void bench_measure(const bench_options * options, bench_function body, bench_function reset, void * data)
+{
+    double * times = (double *)malloc(sizeof(double) * options->repeats);
+    double   start;
+    int      i;
+
+    for (i = 0; i < options->warmup; ++i)
+    {
+        if (reset != NULL)
+            reset(data);
+
+        body(data);
+    }
+
+    for (i = 0; i < options->repeats; ++i)
+    {
+        if (reset != NULL)
+            reset(data);
+
+        start = bench_now();
+        body(data);
+        times[i] = bench_now() - start;
+    }
+
+    bench_report(options,times);
+    free(times);
+}
+
+// fork server descriptors
+#define BENCH_CONTROL_FD 198
+#define BENCH_STATUS_FD  199
+
+// serve runs on request; returns false if nobody is listening
+static bool bench_serve(const bench_options * options, bench_function body, bench_function reset, void * data)
+{
+    static const char hello[4] = { 'A', 'F', 'S', '1' };
+    uint32_t request;
+    int32_t  status;
+    pid_t    pid;
+
+    if (write(BENCH_STATUS_FD,hello,sizeof(hello)) != sizeof(hello))
+        return false;
+
+    while (read(BENCH_CONTROL_FD,&request,sizeof(request)) == sizeof(request))
+    {
+        fflush(stdout);
+        pid = fork();
+
+        if (pid == 0)
+        {
+            close(BENCH_CONTROL_FD);
+            close(BENCH_STATUS_FD);
+            bench_measure(options,body,reset,data);
+            exit(0);
+        }
+
+        status = -1;
+
+        if (pid > 0)
+            waitpid(pid,&status,0);
+
+        if (write(BENCH_STATUS_FD,&status,sizeof(status)) != sizeof(status))
+            break;
+    }
+
+    return true;
+}
+
+// run a benchmark, as a fork server if asked
+static int bench_run(const bench_options * options, bench_function body, bench_function reset, void * data)
+{
+    if (!options->fork_server || !bench_serve(options,body,reset,data))
+        bench_measure(options,body,reset,data);
+
+    return 0;
+}
+
+#endif
@@ -27,6 +27,8 @@
 #include <string.h>
 #include <math.h>
 
+#include "benchharness.h"
+
 // adjust size of test for environment
 //static const int N = 600;
 #define N 600
@@ -78,25 +80,33 @@ static v_t v1[ARRAY_SIZE];
 static v_t v2[ARRAY_SIZE];
 static double r[ARRAY_SIZE];
 
-int main(int argc, char * argv[])
+// what we're timing
+static void run_distbench(void * data)
 {
-    // general purpose indices
     int i, j;
+    int rows = bench_scaled(ARRAY_SIZE);
     
-    // do we have verbose output?
-    bool   ga_testing = false;
-    
-    if (argc > 1)
+    for (i = 0; i < rows; ++i)
     {
-        for (i = 1; i < argc; ++i)
-        {
-            if (!strcmp(argv[i],"-ga"))
-            {
-                ga_testing = true;
-                break;
-            }
-        }
+        r[i] = 0.0;
+        
+        for (j = 0; j < ARRAY_SIZE; ++j)
+            r[i] += distance(v1[i], v2[j]);
     }
+
+    double sum = 0.0;
+
+    for (i = 0; i < rows; ++i)
+        sum += r[i];
+
+    bench_checksum(sum);
+}
+
+int main(int argc, char * argv[])
+{
+    int i;
+    
+    bench_options options = bench_parse("distbench",argc,argv);
     
     // initialize
     for (i = 0; i < ARRAY_SIZE; ++i)
@@ -110,31 +120,6 @@ int main(int argc, char * argv[])
         v2[i].z = random_double();
     }
 
-    // get starting time
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
-    
     // time this
-    for (i = 0; i < ARRAY_SIZE; ++i)
-    {
-        r[i] = 0.0;
-        
-        for (j = 0; j < ARRAY_SIZE; ++j)
-            r[i] += distance(v1[i], v2[j]);
-    }
-
-    // get final time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
-
-    // report runtime
-    if (ga_testing)
-        fprintf(stdout,"%f",run_time);
-    else        
-        fprintf(stdout,"distbench (Std. C) run time: %f\n",run_time);
-    
-    fflush(stdout);
-
-    // done    
-    return 0;
+    return bench_run(&options,run_distbench,NULL,NULL);
 }
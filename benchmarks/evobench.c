@@ -38,6 +38,8 @@
 #include <float.h>
 #include <math.h>
 
+#include "benchharness.h"
+
 // adjust size of test for environment
 static const int N = 200;
 
@@ -115,8 +117,9 @@ double formula(double x, double y)
 }
 
 //-------------------------------------------------------------------
-// a genetic algorithm to optimize the output of BlackBox
-void optimize(size_t pop_size,
+// a genetic algorithm to optimize the output of BlackBox; returns the
+//   best output found
+double optimize(size_t pop_size,
               size_t num_gens,
               float  cross_rate,
               float  mutate_rate)
@@ -276,44 +279,18 @@ void optimize(size_t pop_size,
     free(child_x);
     free(child_y);
     free(fitness);
+
+    return fit_high;
 }
     
+// what we're timing
+static void run_evobench(void * data)
+{
+    bench_checksum(optimize(1000,bench_scaled(N),0.5,0.1));
+}
+
 int main(int argc, char* argv[])
 {
-    // do we have verbose output?
-    bool   ga_testing = false;
-    
-    if (argc > 1)
-    {
-        for (int n = 1; n < argc; ++n)
-        {
-            if (!strcmp(argv[n],"-ga"))
-            {
-                ga_testing = true;
-                break;
-            }
-        }
-    }
-    
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
-    
-    // evolve
-    optimize(1000,N,0.5,0.1);
-
-    // get final time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
-
-    // report runtime
-    if (ga_testing)
-        printf("%f",run_time);
-    else        
-        printf("evobench (Std. C) run time: %f\n",run_time);
-    
-    fflush(stdout);
-    
-    //done
-    return 0;
+    bench_options options = bench_parse("evobench",argc,argv);
+    return bench_run(&options,run_evobench,NULL,NULL);
 }
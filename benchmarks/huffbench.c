@@ -34,6 +34,8 @@
 #include <math.h>
 #include <stdint.h>
 
+#include "benchharness.h"
+
 // embedded random number generator; ala Park and Miller
 static       int32_t seed = 1325;
 static const int32_t IA   = 16807;
@@ -415,24 +417,26 @@ void compdecomp(byte * data, size_t data_len)
     free(comp);
 }
 
-int main(int argc, char ** argv)
+// what we're timing
+static void run_huffbench(void * data)
 {
     int i;
+    int size = bench_scaled(TEST_SIZE);
+    uint32_t hash = 0;
     
-    // do we have verbose output?
-    bool ga_testing = false;
-    
-    if (argc > 1)
-    {
-        for (i = 1; i < argc; ++i)
-        {
-            if (!strcmp(argv[1],"-ga"))
-            {
-                ga_testing = true;
-                break;
-            }
-        }
-    }
+    for (i = 0; i < NUM_LOOPS; ++i)
+        compdecomp((byte *)data,size);
+
+    // decompression restores the data
+    for (i = 0; i < size; ++i)
+        hash = hash * 31 + ((byte *)data)[i];
+
+    bench_checksum((double)hash);
+}
+
+int main(int argc, char ** argv)
+{
+    bench_options options = bench_parse("huffbench",argc,argv);
     
     // initialization
     byte * test_data = generate_test_data(TEST_SIZE);
@@ -443,17 +447,8 @@ int main(int argc, char ** argv)
     fclose(before);
 #endif
             
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
-
-    // what we're timing
-    for (i = 0; i < NUM_LOOPS; ++i)
-        compdecomp(test_data,TEST_SIZE);
-    
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
+    // time compression and decompression, which restores the data
+    int result = bench_run(&options,run_huffbench,NULL,test_data);
 
 #if defined(VERIFY)
     FILE * after = fopen("huffbench.after","wb");
@@ -464,14 +459,6 @@ int main(int argc, char ** argv)
     // release resources
     free(test_data);
 
-    // report runtime
-    if (ga_testing)
-        fprintf(stdout,"%f",run_time);
-    else        
-        fprintf(stdout,"\nhuffbench (Std. C) run time: %f\n\n",run_time);
-    
-    fflush(stdout);
-    
     // done
-    return 0;
+    return result;
 }
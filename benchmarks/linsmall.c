@@ -25,6 +25,8 @@
 #include <stdbool.h>
 #include <stdio.h>
 
+#include "benchharness.h"
+
 // embedded random number generator; ala Park and Miller
 static       long seed = 1325;
 static const long IA   = 16807;
@@ -53,24 +55,26 @@ static double random_double()
 }
 
 static const int N   =  800;
-static const int NM1 =  799; // N - 1
 static const int NP1 =  801; // N + 1
 
+// rows and columns used; work grows with the cube of the order
+static int order = N;
+
 static int * lup_decompose(double ** a)
 {
     int i, j, k, k2, t;
     double p, temp;
     
-    int * perm = (int *)malloc(sizeof(double) * N);
+    int * perm = (int *)malloc(sizeof(double) * order);
     
-    for (i = 0; i < N; ++i)
+    for (i = 0; i < order; ++i)
         perm[i] = i;
     
-    for (k = 0; k < NM1; ++k)
+    for (k = 0; k < order - 1; ++k)
     {
         p = 0.0;
         
-        for (i = k; i < N; ++i)
+        for (i = k; i < order; ++i)
         {
             temp = fabs(a[i][k]);
             
@@ -90,18 +94,18 @@ static int * lup_decompose(double ** a)
         perm[k] = perm[k2];
         perm[k2] = t;
 
-        for (i = 0; i < N; ++i)
+        for (i = 0; i < order; ++i)
         {
             temp = a[k][i];
             a[k][i] = a[k2][i];
             a[k2][i] = temp;
         }
         
-        for (i = k + 1; i < N; ++i)
+        for (i = k + 1; i < order; ++i)
         {
             a[i][k] /= a[k][k];
             
-            for (j = k + 1; j < N; ++j)
+            for (j = k + 1; j < order; ++j)
                 a[i][j] -= a[i][k] * a[k][j];
         }
     }
@@ -114,16 +118,16 @@ static double * lup_solve(double ** a, int * perm, double * b)
     int i, j, j2;
     double sum, u;
     
-    double * y = (double *)malloc(sizeof(double) * N);
-    double * x = (double *)malloc(sizeof(double) * N);
+    double * y = (double *)malloc(sizeof(double) * order);
+    double * x = (double *)malloc(sizeof(double) * order);
     
-    for (int i = 0; i < N; ++i)
+    for (int i = 0; i < order; ++i)
     {
         y[i] = 0.0;
         x[i] = 0.0;
     }
     
-    for (i = 0; i < N; ++i)
+    for (i = 0; i < order; ++i)
     {
         sum = 0.0;
         j2 = 0;
@@ -137,14 +141,14 @@ static double * lup_solve(double ** a, int * perm, double * b)
         y[i] = b[perm[i]] - sum;
     }
     
-    i = NM1;
+    i = order - 1;
     
     while (1)
     {
         sum = 0.0;
         u   = a[i][i];
         
-        for (j = i + 1; j < N; ++j)
+        for (j = i + 1; j < order; ++j)
             sum += a[i][j] * x[j];
         
         x[i] = (y[i] - sum) / u;
@@ -160,50 +164,79 @@ static double * lup_solve(double ** a, int * perm, double * b)
     return x;
 }
 
-int main(void)
+// test data
+typedef struct
 {
-    int i, j;
+    double ** a;
+    double *  b;
+} lup_test;
 
-    // generate test data            
-    double ** a = (double **)malloc(sizeof(double *) * N);
+// fill the matrix and vector, which each run consumes
+static void reset_linsmall(void * data)
+{
+    lup_test * test = (lup_test *)data;
+    int i, j;
     
     for (i = 0; i < N; ++i)
     {
-        a[i] = (double *)malloc(sizeof(double) * N);
-        
-        for (int j = 0; j < N; ++j)
-            a[i][j] = random_double();
+        for (j = 0; j < N; ++j)
+            test->a[i][j] = random_double();
     }
     
-    double * b = (double *)malloc(sizeof(double) * N);
-    
     for (i = 0; i < N; ++i)
-         b[i] = random_double();
+         test->b[i] = random_double();
+}
+
+// what we're timing
+static void run_linsmall(void * data)
+{
+    lup_test * test = (lup_test *)data;
+    
+    int * p = lup_decompose(test->a);
+    double * r = lup_solve(test->a,p,test->b);
+    double sum = 0.0;
+    int i;
+
+    for (i = 0; i < order; ++i)
+        sum += r[i];
+
+    bench_checksum(sum);
     
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
+    free(p);
+    free(r);
+}
+
+int main(int argc, char ** argv)
+{
+    int i;
+
+    bench_options options = bench_parse("linsmall",argc,argv);
+
+    // a smaller system for a scaled workload
+    order = (int)(N * cbrt(options.scale) + 0.5);
+
+    if (order < 2)
+        order = 2;
 
-    // what we're timing
-    int * p = lup_decompose(a);
-    double * r = lup_solve(a,p,b);
+    // allocate test data
+    lup_test test;
+    test.a = (double **)malloc(sizeof(double *) * N);
     
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
+    for (i = 0; i < N; ++i)
+        test.a[i] = (double *)malloc(sizeof(double) * N);
+    
+    test.b = (double *)malloc(sizeof(double) * N);
+    
+    // time it
+    int result = bench_run(&options,run_linsmall,reset_linsmall,&test);
     
     // clean up
     for (i = 0; i < N; ++i)
-        free(a[i]);
+        free(test.a[i]);
     
-    free(a);
-    free(b);
-    free(p);
-    free(r);
-    
-    // send result
-    fprintf(stdout,"%f",run_time);
+    free(test.a);
+    free(test.b);
 
     // done
-    return 0;
+    return result;
 }
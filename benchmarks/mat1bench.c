@@ -26,6 +26,8 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "benchharness.h"
+
 // adjust size of test for environment
 //static const int N = 600;
 #define N 600
@@ -61,64 +63,61 @@ double a[N][N];
 double b[N][N];
 double c[N][N];
 
-int main(int argc, char * argv[])
+// what we're timing
+static void run_mat1bench(void * data)
 {
-    // general purpose indices
     int i, j, k;
+    int rows = bench_scaled(N);
     
-    // do we have verbose output?
-    bool   ga_testing = false;
-    
-    if (argc > 1)
+    for (i = 0; i < rows; ++i)
     {
-        for (i = 1; i < argc; ++i)
+        for (j = 0; j < N; ++j)
         {
-            if (!strcmp(argv[i],"-ga"))
+            for (k = 0; k < N; ++k)
             {
-                ga_testing = true;
-                break;
+                c[i][j] = c[i][j] + a[i][k] * b[k][j];
             }
         }
     }
+
+    double sum = 0.0;
+
+    for (i = 0; i < rows; ++i)
+    {
+        for (j = 0; j < N; ++j)
+            sum += c[i][j];
+    }
+
+    bench_checksum(sum);
+}
+
+// clear the product before each run
+static void reset_mat1bench(void * data)
+{
+    int i, j;
     
     for (i = 0; i < N; ++i)
     {
         for (j = 0; j < N; ++j)
-        {
-            a[i][j] = random_double();
-            b[i][j] = random_double();
             c[i][j] = 0.0;
-        }
     }
+}
+
+int main(int argc, char * argv[])
+{
+    // general purpose indices
+    int i, j;
     
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
+    bench_options options = bench_parse("mat1bench",argc,argv);
     
-    // generate mandelbrot set
     for (i = 0; i < N; ++i)
     {
         for (j = 0; j < N; ++j)
         {
-            for (k = 0; k < N; ++k)
-            {
-                c[i][j] = c[i][j] + a[i][k] * b[k][j];
-            }
+            a[i][j] = random_double();
+            b[i][j] = random_double();
         }
     }
-
-    // get final time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
-
-    // report runtime
-    if (ga_testing)
-        fprintf(stdout,"%f",run_time);
-    else        
-        fprintf(stdout,"mat1bench (Std. C) run time: %f\n",run_time);
     
-    fflush(stdout);
-
-    // done    
-    return 0;
+    return bench_run(&options,run_mat1bench,reset_mat1bench,NULL);
 }
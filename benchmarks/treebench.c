@@ -27,6 +27,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 
+#include "benchharness.h"
+
 static const int TEST_SIZE =  10000000;
 static const int ORDER     =        16;
 static const int MAX_KEY   =      4096;
@@ -1022,90 +1024,82 @@ static btree_key_t random_key(btree_key_t limit)
     return result;
 }
 
-int main(int argc, char ** argv)
+// state of the test
+typedef struct
 {
-    int i;
-    
-    // do we have verbose output?
-    bool ga_testing = false;
-    
-    if (argc > 1)
-    {
-        for (i = 1; i < argc; ++i)
-        {
-            if (!strcmp(argv[1],"-ga"))
-            {
-                ga_testing = true;
-                break;
-            }
-        }
-    }
-    
-    // initialize
-    btree * tree = create_btree(16);
-    
-    bool flags[MAX_KEY];
-    
-    for (i = 0; i < MAX_KEY; ++i)
-        flags[i] = false;
-    
-    // get starting time    
-    struct timespec start, stop;
-    clock_gettime(CLOCK_REALTIME,&start);
+    btree * tree;
+    bool *  flags;
+} tree_test;
 
-    // what we're timing
-    for (int n = 0; n < TEST_SIZE; ++n)
+// what we're timing
+static void run_treebench(void * data)
+{
+    tree_test * test = (tree_test *)data;
+    int count = bench_scaled(TEST_SIZE);
+    int found = 0;
+    
+    for (int n = 0; n < count; ++n)
     {
         // pick a key
         btree_key_t key = random_key(MAX_KEY);
         
         // is the key in the tree?
-        btree_data_t data = btree_find(tree,key);
+        btree_data_t data = btree_find(test->tree,key);
         
         if (data == NULL_DATA)
         {
-            btree_insert(tree,key,(btree_data_t)key);
-            flags[key] = true;
+            btree_insert(test->tree,key,(btree_data_t)key);
+            test->flags[key] = true;
         }
         else
         {
-            btree_remove(tree,key);
-            flags[key] = false;
+            btree_remove(test->tree,key);
+            test->flags[key] = false;
+            ++found;
         }
     }
+
+    bench_checksum(found);
+}
+
+int main(int argc, char ** argv)
+{
+    int i;
     
-    // calculate run time
-    clock_gettime(CLOCK_REALTIME,&stop);        
-    double run_time = (stop.tv_sec - start.tv_sec) + (double)(stop.tv_nsec - start.tv_nsec) / 1000000000.0;
+    bench_options options = bench_parse("treebench",argc,argv);
+    
+    // initialize
+    tree_test test;
+    test.tree  = create_btree(16);
+    test.flags = (bool *)malloc(sizeof(bool) * MAX_KEY);
+    
+    for (i = 0; i < MAX_KEY; ++i)
+        test.flags[i] = false;
+    
+    // runs after the first continue with the tree left by the one before
+    int result = bench_run(&options,run_treebench,NULL,&test);
     
 #if defined(VERIFY)
     // verify
     for (btree_key_t k = 0; k < MAX_KEY; ++k)
     {
-        if (NULL_DATA == btree_find(tree,k))
+        if (NULL_DATA == btree_find(test.tree,k))
         {
-            if (flags[k])
+            if (test.flags[k])
                 fprintf(stderr,"VERIFICATION ERROR: %l found, and shouldn't have been\n",k);
         }
         else
         {
-            if (!flags[k])
+            if (!test.flags[k])
                 fprintf(stderr,"VERIFICATION ERROR: %l not found, and should have been\n",k);
         }
     }
 #endif
     
     // clean up
-    free_btree(tree);
-
-    // report runtime
-    if (ga_testing)
-        fprintf(stdout,"%f",run_time);
-    else        
-        fprintf(stdout,"\ntreebench (Std. C) run time: %f\n\n",run_time);
-    
-    fflush(stdout);
+    free_btree(test.tree);
+    free(test.flags);
     
     // done
-    return 0;
+    return result;
 }
@@ -57,6 +57,7 @@ void show_usage()
          << "essential options:\n"
          << "   -config {config file name}              (i.e., -config gcc34_opteron.acovea\n"
          << "   -input {source base name}               (i.e., -input almabench.c)\n"
+         << "          or {name:weight,...}              (i.e., -input almabench.c:1,huffbench.c:2)\n"
          << "\noptions for tuning the evolutionary algorithm:\n"
          << "   -n {number of populations to create}\n"
          << "   -p {size of each population}\n"
@@ -68,7 +69,76 @@ void show_usage()
          << "   -no-scaling                             (no fitness scaling)\n"
          << "   -size                                   (optimize for code size)\n"
          << "   -retval                                 (optimize for return value)\n"
-         << "   -seed {random number seed}\n\n"
+         << "   -pareto                                 (optimize speed and size together)\n"
+         << "   -seed {random number seed}\n"
+         << "\noptions for controlling evaluation:\n"
+         << "   -no-cache                               (benchmark identical binaries again)\n"
+         << "   -cache-whole                            (fingerprint entire binary, not just code)\n"
+         << "   -refine {samples per binary}            (measurements averaged before reuse;\n"
+         << "                                            default 3, 1 for no refinement)\n"
+         << "   -surrogate {candidates per child}       (screen offspring with a surrogate model)\n"
+         << "   -explore {fraction}                     (unscreened share of surrogate picks)\n"
+         << "   -jobs {number of tests at once}         (for -steady and repeated measurements)\n"
+         << "   -repeats {runs per test}                (for repeated measurements)\n"
+         << "   -fork-server                            (start benchmarks once for repeated runs,\n"
+         << "                                            if they support it)\n"
+         << "   -fidelity {scale}                       (screen each generation with workloads\n"
+         << "                                            scaled down to this fraction, e.g. 0.1)\n"
+         << "   -promote {fraction}                     (share of each screening rung moved on to\n"
+         << "                                            a larger workload; default 0.33)\n"
+         << "   -verify                                 (reject options whose benchmark checksum\n"
+         << "                                            differs from the baseline's)\n"
+         << "   -tolerance {fraction}                   (relative checksum difference allowed;\n"
+         << "                                            default 1e-9)\n"
+         << "   -fitness {metric[:weight],...}          (benchmark metrics summed into fitness;\n"
+         << "                                            default from the configuration, or time)\n"
+         << "   -function {name}                        (tune a function's options separately;\n"
+         << "                                            may be repeated)\n"
+         << "\noptions for refining the final result:\n"
+         << "   -polish                                 (hill-climb and minimize best options)\n"
+         << "   -threshold {fraction}                   (smallest fitness change considered real)\n"
+         << "   -ablation                               (measure the impact of each final option)\n"
+         << "\noptions for long runs:\n"
+         << "   -checkpoint {file name}                 (save the state of the run periodically)\n"
+         << "   -checkpoint-every {generations}         (default is every generation)\n"
+         << "   -checkpoint-minutes {minutes}           (also save after this much time)\n"
+         << "   -resume {file name}                     (continue a run from a checkpoint)\n"
+         << "   -island {address}                       (exchange migrants with other processes;\n"
+         << "                                            address is unix:{path} or udp:{host}:{port})\n"
+         << "   -peer {address}                         (another island; may be repeated)\n"
+         << "   -steady                                 (steady-state evolution; breeds a new organism\n"
+         << "                                            whenever one of the -jobs test slots is free)\n"
+         << "   -max-tests {number}                     (stop after this many fitness tests)\n"
+         << "   -max-minutes {minutes}                  (stop after this much wall-clock time)\n"
+         << "   -target {fraction}                      (stop when fitness reaches this fraction\n"
+         << "                                            of the best baseline's, e.g. 0.9)\n"
+         << "   -stall {generations}                    (stop when the best fitness has not improved\n"
+         << "                                            for this many generations)\n"
+         << "   -epsilon {fraction}                     (smallest improvement that counts; default 0.001)\n"
+         << "   -reserve {fraction}                     (share of -max-tests and -max-minutes kept\n"
+         << "                                            for the final report; default 0.1)\n"
+         << "   -adaptive                               (adapt mutation and crossover rates to\n"
+         << "                                            hold population diversity in a band)\n"
+         << "   -diversity-low {fraction}               (default 0.1)\n"
+         << "   -diversity-high {fraction}              (default 0.3)\n"
+         << "   -unique                                 (breed again or mutate children that\n"
+         << "                                            repeat a genome in their population)\n"
+         << "   -unique-history                         (... or any genome tested in the run)\n"
+         << "   -unique-retries {number}                (attempts at a new genome; default 8)\n"
+         << "   -seed-baselines                         (start populations with the baselines'\n"
+         << "                                            flags, mapped onto the options)\n"
+         << "   -seed-file {file name}                  (start populations with option lists from\n"
+         << "                                            a file written by -save-seeds)\n"
+         << "   -seed-fraction {fraction}               (share of each population seeded; default 0.25)\n"
+         << "   -seed-mutation {rate}                   (mutation of reused seeds; default 0.05)\n"
+         << "   -save-seeds {file name}                 (write final populations for later runs)\n"
+         << "   -log {file name}                        (write every event, including each test,\n"
+         << "                                            as a line of JSON)\n"
+         << "   -timing                                 (report where time goes, every generation\n"
+         << "                                            and at the end of the run)\n"
+         << "   -timing-file {file name}                (write phase timing histograms)\n"
+         << "   -trace {file name}                      (write a timeline of tests, breeding and\n"
+         << "                                            reports for Perfetto or chrome://tracing)\n\n"
          << "example:\n"
          << "   runacovea -config gcc34_opteron.acovea -input huffbench.c\n\n";
 }
@@ -100,6 +170,10 @@ int main(int argc, char * argv[])
     string config_name;
     bool scaling           = true;
     optimization_mode mode = OPTIMIZE_SPEED;
+    run_settings settings;
+    string log_name;
+    string fitness_text;
+    vector<string> functions;
     
     string id;
     
@@ -178,6 +252,228 @@ int main(int argc, char * argv[])
         {
             mode = OPTIMIZE_RETVAL;
         }
+        else if (opt->m_name == "pareto")
+        {
+            mode = OPTIMIZE_PARETO;
+        }
+        else if (opt->m_name == "no-cache")
+        {
+            settings.m_use_cache = false;
+        }
+        else if (opt->m_name == "cache-whole")
+        {
+            settings.m_cache_code_only = false;
+        }
+        else if (opt->m_name == "refine")
+        {
+            settings.m_cache_refine = atol(opt->m_value.c_str());
+            
+            if (settings.m_cache_refine < 1)
+                settings.m_cache_refine = 1;
+        }
+        else if (opt->m_name == "surrogate")
+        {
+            settings.m_use_surrogate    = true;
+            settings.m_surrogate_screen = atol(opt->m_value.c_str());
+            
+            if (settings.m_surrogate_screen < 2)
+                settings.m_surrogate_screen = 2;
+        }
+        else if (opt->m_name == "explore")
+        {
+            settings.m_surrogate_explore = atof(opt->m_value.c_str());
+            
+            if (settings.m_surrogate_explore < 0.0)
+                settings.m_surrogate_explore = 0.0;
+                
+            if (settings.m_surrogate_explore > 1.0)
+                settings.m_surrogate_explore = 1.0;
+        }
+        else if (opt->m_name == "jobs")
+        {
+            settings.m_jobs = atol(opt->m_value.c_str());
+            
+            if (settings.m_jobs < 1)
+                settings.m_jobs = 1;
+        }
+        else if (opt->m_name == "repeats")
+        {
+            settings.m_repeats = atol(opt->m_value.c_str());
+            
+            if (settings.m_repeats < 1)
+                settings.m_repeats = 1;
+        }
+        else if (opt->m_name == "polish")
+        {
+            settings.m_polish = true;
+        }
+        else if (opt->m_name == "ablation")
+        {
+            settings.m_ablation = true;
+        }
+        else if (opt->m_name == "threshold")
+        {
+            settings.m_polish_threshold = atof(opt->m_value.c_str());
+            
+            if (settings.m_polish_threshold < 0.0)
+                settings.m_polish_threshold = 0.0;
+        }
+        else if (opt->m_name == "checkpoint")
+        {
+            settings.m_checkpoint_file = opt->m_value;
+        }
+        else if (opt->m_name == "checkpoint-every")
+        {
+            settings.m_checkpoint_every = atol(opt->m_value.c_str());
+            
+            if (settings.m_checkpoint_every < 1)
+                settings.m_checkpoint_every = 1;
+        }
+        else if (opt->m_name == "checkpoint-minutes")
+        {
+            settings.m_checkpoint_minutes = atof(opt->m_value.c_str());
+            
+            if (settings.m_checkpoint_minutes < 0.0)
+                settings.m_checkpoint_minutes = 0.0;
+        }
+        else if (opt->m_name == "resume")
+        {
+            settings.m_resume_file = opt->m_value;
+        }
+        else if (opt->m_name == "island")
+        {
+            settings.m_island_address = opt->m_value;
+        }
+        else if (opt->m_name == "peer")
+        {
+            settings.m_island_peers.push_back(opt->m_value);
+        }
+        else if (opt->m_name == "steady")
+        {
+            settings.m_steady_state = true;
+        }
+        else if (opt->m_name == "max-tests")
+        {
+            settings.m_max_evaluations = (size_t)atol(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "max-minutes")
+        {
+            settings.m_max_minutes = atof(opt->m_value.c_str());
+
+            if (settings.m_max_minutes < 0.0)
+                settings.m_max_minutes = 0.0;
+        }
+        else if (opt->m_name == "target")
+        {
+            settings.m_target_ratio = atof(opt->m_value.c_str());
+
+            if (settings.m_target_ratio < 0.0)
+                settings.m_target_ratio = 0.0;
+        }
+        else if (opt->m_name == "stall")
+        {
+            settings.m_stall_generations = (size_t)atol(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "epsilon")
+        {
+            settings.m_stall_epsilon = atof(opt->m_value.c_str());
+
+            if (settings.m_stall_epsilon < 0.0)
+                settings.m_stall_epsilon = 0.0;
+        }
+        else if (opt->m_name == "reserve")
+        {
+            settings.m_budget_reserve = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "adaptive")
+        {
+            settings.m_adaptive_rates = true;
+        }
+        else if (opt->m_name == "diversity-low")
+        {
+            settings.m_diversity_low = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "diversity-high")
+        {
+            settings.m_diversity_high = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "unique")
+        {
+            settings.m_unique_children = true;
+        }
+        else if (opt->m_name == "unique-history")
+        {
+            settings.m_unique_children = true;
+            settings.m_unique_history  = true;
+        }
+        else if (opt->m_name == "unique-retries")
+        {
+            settings.m_unique_retries = (size_t)atol(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "seed-baselines")
+        {
+            settings.m_seed_baselines = true;
+        }
+        else if (opt->m_name == "seed-file")
+        {
+            settings.m_seed_file = opt->m_value;
+        }
+        else if (opt->m_name == "seed-fraction")
+        {
+            settings.m_seed_fraction = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "seed-mutation")
+        {
+            settings.m_seed_mutation = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "save-seeds")
+        {
+            settings.m_save_seeds_file = opt->m_value;
+        }
+        else if (opt->m_name == "fork-server")
+        {
+            settings.m_fork_server = true;
+        }
+        else if (opt->m_name == "fidelity")
+        {
+            settings.m_fidelity_scale = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "promote")
+        {
+            settings.m_fidelity_promote = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "verify")
+        {
+            settings.m_verify = true;
+        }
+        else if (opt->m_name == "tolerance")
+        {
+            settings.m_verify_tolerance = atof(opt->m_value.c_str());
+        }
+        else if (opt->m_name == "fitness")
+        {
+            fitness_text = opt->m_value;
+        }
+        else if (opt->m_name == "function")
+        {
+            functions.push_back(opt->m_value);
+        }
+        else if (opt->m_name == "log")
+        {
+            log_name = opt->m_value;
+        }
+        else if (opt->m_name == "timing")
+        {
+            settings.m_report_timing = true;
+        }
+        else if (opt->m_name == "timing-file")
+        {
+            settings.m_timing_file = opt->m_value;
+        }
+        else if (opt->m_name == "trace")
+        {
+            settings.m_trace_file = opt->m_value;
+        }
         else if (opt->m_name == "seed")
         {
             libevocosm::globals::set_random_seed(atol(opt->m_value.c_str()));
@@ -232,9 +528,23 @@ int main(int argc, char * argv[])
     
     // create application object
     application target(config_name);
+
+    // the command line overrides the configuration's choice of metrics
+    if (!fitness_text.empty())
+        target.set_fitness(fitness_formula(fitness_text));
+
+    // each tuned function gets its own options
+    if (!functions.empty())
+        target.set_functions(functions);
     
-    // create a listener
-    acovea_listener_stdout listener;
+    // create a listener, which also logs events if asked
+    acovea_listener_stdout console;
+    acovea_listener_json * log = NULL;
+
+    if (!log_name.empty())
+        log = new acovea_listener_json(log_name,console);
+
+    acovea_listener & listener = (log != NULL) ? static_cast<acovea_listener &>(*log) : console;
     
     // create a world
     acovea_world world(listener,
@@ -248,7 +558,8 @@ int main(int argc, char * argv[])
                        mutation_rate,
                        crossover_rate,
                        scaling,
-                       generations);
+                       generations,
+                       settings);
 
     try
     {    
@@ -263,6 +574,9 @@ int main(int argc, char * argv[])
     {
         cerr << "runacovea: unknown exception\n";
     }
+
+    // finish the log
+    delete log;
     
     // outa here
     return 0;
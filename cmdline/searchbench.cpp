@@ -0,0 +1,605 @@
+//---------------------------------------------------------------------
+//  ACOVEA -- Analysis of Compiler Options Via Evolution Algorithm
+//
+//  searchbench.cpp
+//
+//  Measures how quickly the genetic algorithm finds good options, by
+//  running it many times on synthetic landscapes (see acovea-synthcc).
+//---------------------------------------------------------------------
+//
+//  Copyright 2003, 2004, 2005 Scott Robert Ladd
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the
+//      Free Software Foundation, Inc.
+//      59 Temple Place - Suite 330
+//      Boston, MA 02111-1307, USA.
+//
+//-----------------------------------------------------------------------
+//
+//  For more information on this software package, please visit
+//  Scott's web site, Coyote Gulch Productions, at:
+//
+//      http://www.coyotegulch.com
+//
+//-----------------------------------------------------------------------
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+#include "libcoyotl/command_line.h"
+using namespace libcoyotl;
+
+#include "libacovea/acovea.h"
+using namespace acovea;
+
+//----------------------------------------------------------
+// evolutionary settings being compared
+struct variant
+{
+    string name;
+    size_t pops;
+    size_t size;
+    double survival;
+    double migration;
+    double mutation;
+    double crossover;
+    bool   scaling;
+};
+
+// the settings runacovea uses, with smaller populations so that a
+//   modest budget spans many generations
+static variant default_variant(const string & a_name)
+{
+    variant result;
+    result.name      = a_name;
+    result.pops      = 3;
+    result.size      = 20;
+    result.survival  = 0.10;
+    result.migration = 0.05;
+    result.mutation  = 0.01;
+    result.crossover = 1.00;
+    result.scaling   = true;
+    return result;
+}
+
+// read "name:key=value,..."; keys are pops, size, survival, migration,
+//   mutation, crossover and scaling
+static variant parse_variant(const string & a_text)
+{
+    size_t colon = a_text.find(':');
+    variant result = default_variant(a_text.substr(0,colon));
+
+    if (result.name.empty())
+        throw runtime_error("variant without a name: " + a_text);
+
+    if (colon == string::npos)
+        return result;
+
+    stringstream fields(a_text.substr(colon + 1));
+    string field;
+
+    while (getline(fields,field,','))
+    {
+        size_t equals = field.find('=');
+
+        if (equals == string::npos)
+            throw runtime_error("variant setting without a value: " + field);
+
+        string key   = field.substr(0,equals);
+        double value = atof(field.substr(equals + 1).c_str());
+
+        if (key == "pops")
+            result.pops = (value < 1.0) ? 1 : (size_t)value;
+        else if (key == "size")
+            result.size = (value < 2.0) ? 2 : (size_t)value;
+        else if (key == "survival")
+            result.survival = min(1.0,max(0.0,value));
+        else if (key == "migration")
+            result.migration = min(0.9,max(0.0,value));
+        else if (key == "mutation")
+            result.mutation = min(0.95,max(0.0,value));
+        else if (key == "crossover")
+            result.crossover = min(1.0,max(0.0,value));
+        else if (key == "scaling")
+            result.scaling = (value != 0.0);
+        else
+            throw runtime_error("unknown variant setting: " + key);
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------
+// a quiet listener that records the best result against the number of
+//   tests, counted as the world counts them; on the synthetic landscapes,
+//   the best is judged by the noise-free "expected" run time each program
+//   reports
+class curve_listener : public acovea_listener
+{
+    public:
+        curve_listener()
+          : m_evaluations(0.0),
+            m_best(BOGUS_RUN_TIME),
+            m_committed_evaluations(0.0),
+            m_curve(),
+            m_pending()
+        {
+            // nada
+        }
+
+        virtual void ping_generation_begin(size_t a_generation_number) { }
+        virtual void ping_generation_end(size_t a_generation_number) { }
+        virtual void ping_population_begin(size_t a_population_number) { }
+        virtual void ping_population_end(size_t a_population_number) { }
+        virtual void ping_fitness_test_begin(size_t a_organism_number) { }
+        virtual void ping_fitness_test_end(size_t a_organism_number) { }
+        virtual void report(const string & a_text) { }
+        virtual void report_error(const string & a_text) { }
+        virtual void run_complete() { }
+        virtual void yield() { }
+        virtual void report_config(const string & a_text) { }
+
+        virtual void report_final(vector<test_result> & a_results,
+                                  vector<option_zscore> & a_zscores,
+                                  vector<option_impact> & a_impacts)
+        {
+            // nada
+        }
+
+        // each improvement adds a point at the test that found it; a
+        //   screening test at a reduced scale costs its share of a test,
+        //   but doesn't count as a result, and a cached result costs nothing.
+        //   Improvement is judged by the expected time itself, so that a
+        //   lucky measurement can't make the curve rise
+        virtual void report_evaluation(const evaluation_record & a_record)
+        {
+            if (!a_record.m_cache_hit)
+                m_evaluations += a_record.m_scale;
+
+            if ((a_record.m_scale < 1.0) || (a_record.m_fitness >= BOGUS_RUN_TIME))
+                return;
+
+            map<string,string>::const_iterator expected = a_record.m_metrics.find("expected");
+            double best = (expected != a_record.m_metrics.end()) ? atof(expected->second.c_str()) : a_record.m_fitness;
+
+            if (best < m_best)
+            {
+                m_best = best;
+                m_pending.push_back(make_pair(m_evaluations,m_best));
+            }
+        }
+
+        // a generation's improvements become part of the curve; tests made
+        //   afterward for the final report are not part of the search
+        virtual void report_generation(size_t a_gen_no, double a_avg_fitness)
+        {
+            m_committed_evaluations = m_evaluations;
+            m_curve.insert(m_curve.end(),m_pending.begin(),m_pending.end());
+            m_pending.clear();
+        }
+
+        double evaluations() const
+        {
+            return m_committed_evaluations;
+        }
+
+        const vector< pair<double,double> > & curve() const
+        {
+            return m_curve;
+        }
+
+    private:
+        double m_evaluations;
+        double m_best;
+        double m_committed_evaluations;
+        vector< pair<double,double> > m_curve;
+        vector< pair<double,double> > m_pending;
+};
+
+//----------------------------------------------------------
+// the outcome of one run
+struct run_result
+{
+    double evaluations;
+    double best;
+    double auc;
+    double to_target;   // negative if the target was never reached
+    vector< pair<double,double> > curve;
+};
+
+// the expected run time of a landscape's first baseline, from
+//   acovea-synthcc -explain; BOGUS_RUN_TIME if it can't be had
+static double baseline_time(const string & a_config)
+{
+    application target(a_config);
+    vector<command_elements> baselines = target.get_baselines();
+
+    if (baselines.empty())
+        return BOGUS_RUN_TIME;
+
+    string command = baselines[0].m_command + " -explain " + baselines[0].m_flags;
+    FILE * explain = popen(command.c_str(),"r");
+
+    if (explain == NULL)
+        return BOGUS_RUN_TIME;
+
+    double result = BOGUS_RUN_TIME;
+    char line[1024];
+
+    while (fgets(line,sizeof(line),explain) != NULL)
+    {
+        double time;
+
+        if (sscanf(line,"expected run time: %lf",&time) == 1)
+            result = time;
+    }
+
+    pclose(explain);
+    return result;
+}
+
+// mean of the best-so-far over a budget of tests: before the first
+//   point, the reference (the baseline) stands in, or the first result
+//   if there is none; after the last point, the last
+static double area_under_curve(const vector< pair<double,double> > & a_curve, double a_budget, double a_reference)
+{
+    if (a_curve.empty() || (a_budget <= 0.0))
+        return BOGUS_RUN_TIME;
+
+    double area = 0.0;
+    double from = 0.0;
+    double best = (a_reference < BOGUS_RUN_TIME) ? a_reference : a_curve[0].second;
+
+    for (size_t n = 0; n < a_curve.size(); ++n)
+    {
+        double to = min(a_curve[n].first,a_budget);
+        area += best * max(0.0,to - from);
+        from  = max(from,to);
+        best  = a_curve[n].second;
+    }
+
+    area += best * max(0.0,a_budget - from);
+
+    return area / a_budget;
+}
+
+static run_result run_once(const string & a_config, const variant & a_variant, uint32_t a_seed,
+                           size_t a_budget, double a_target, double a_reference, bool a_verify)
+{
+    libevocosm::globals::set_random_seed(a_seed);
+
+    application target(a_config);
+    curve_listener listener;
+
+    run_settings settings;
+    settings.m_max_evaluations = a_budget;
+    settings.m_budget_reserve  = 0.0;
+    settings.m_verify          = a_verify;
+
+    acovea_world world(listener,
+                       "synthetic.c",
+                       OPTIMIZE_SPEED,
+                       target,
+                       a_variant.pops,
+                       a_variant.size,
+                       a_variant.survival,
+                       a_variant.migration,
+                       a_variant.mutation,
+                       a_variant.crossover,
+                       a_variant.scaling,
+                       a_budget,   // generations; the budget ends the run
+                       settings);
+
+    world.run();
+
+    run_result result;
+    result.evaluations = listener.evaluations();
+    result.curve       = listener.curve();
+    result.best        = result.curve.empty() ? BOGUS_RUN_TIME : result.curve.back().second;
+    result.auc         = area_under_curve(result.curve,(double)a_budget,a_reference);
+    result.to_target   = -1.0;
+
+    for (size_t n = 0; n < result.curve.size(); ++n)
+    {
+        if (result.curve[n].second <= a_target)
+        {
+            result.to_target = result.curve[n].first;
+            break;
+        }
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------
+// output, as lines of JSON
+static string json_string(const string & a_text)
+{
+    string result("\"");
+
+    for (size_t n = 0; n < a_text.size(); ++n)
+    {
+        char c = a_text[n];
+
+        if ((c == '"') || (c == '\\'))
+            result += '\\';
+
+        if ((unsigned char)c < 0x20)
+            result += ' ';
+        else
+            result += c;
+    }
+
+    return result + "\"";
+}
+
+static string json_number(double a_value)
+{
+    if ((a_value < 0.0) || (a_value >= BOGUS_RUN_TIME))
+        return "null";
+
+    char text[32];
+    snprintf(text,sizeof(text),"%.6g",a_value);
+    return text;
+}
+
+static double median(vector<double> a_values)
+{
+    if (a_values.empty())
+        return -1.0;
+
+    sort(a_values.begin(),a_values.end());
+    size_t n = a_values.size();
+    return (n % 2) ? a_values[n / 2] : (a_values[n / 2 - 1] + a_values[n / 2]) / 2.0;
+}
+
+static void report_run(const string & a_config, const variant & a_variant, uint32_t a_seed, const run_result & a_result)
+{
+    cout << "{\"event\":\"run\",\"landscape\":" << json_string(a_config)
+         << ",\"variant\":" << json_string(a_variant.name)
+         << ",\"seed\":" << a_seed
+         << ",\"evaluations\":" << json_number(a_result.evaluations)
+         << ",\"best\":" << json_number(a_result.best)
+         << ",\"auc\":" << json_number(a_result.auc)
+         << ",\"evaluations_to_target\":" << json_number(a_result.to_target)
+         << ",\"curve\":[";
+
+    for (size_t n = 0; n < a_result.curve.size(); ++n)
+    {
+        cout << ((n > 0) ? "," : "") << "[" << json_number(a_result.curve[n].first)
+             << "," << json_number(a_result.curve[n].second) << "]";
+    }
+
+    cout << "]}" << endl;
+}
+
+static void report_summary(const string & a_config, const variant & a_variant, size_t a_budget,
+                           double a_target, const vector<run_result> & a_results)
+{
+    vector<double> aucs;
+    vector<double> to_target;
+    double best_sum = 0.0;
+    size_t best_count = 0;
+
+    for (size_t n = 0; n < a_results.size(); ++n)
+    {
+        if (a_results[n].auc < BOGUS_RUN_TIME)
+            aucs.push_back(a_results[n].auc);
+
+        if (a_results[n].best < BOGUS_RUN_TIME)
+        {
+            best_sum += a_results[n].best;
+            ++best_count;
+        }
+
+        if (a_results[n].to_target >= 0.0)
+            to_target.push_back(a_results[n].to_target);
+    }
+
+    double auc_mean = 0.0;
+    double auc_var  = 0.0;
+
+    for (size_t n = 0; n < aucs.size(); ++n)
+        auc_mean += aucs[n];
+
+    if (!aucs.empty())
+        auc_mean /= aucs.size();
+
+    for (size_t n = 0; n < aucs.size(); ++n)
+        auc_var += (aucs[n] - auc_mean) * (aucs[n] - auc_mean);
+
+    if (aucs.size() > 1)
+        auc_var /= (aucs.size() - 1);
+
+    cout << "{\"event\":\"summary\",\"landscape\":" << json_string(a_config)
+         << ",\"variant\":" << json_string(a_variant.name)
+         << ",\"pops\":" << a_variant.pops
+         << ",\"size\":" << a_variant.size
+         << ",\"survival\":" << json_number(a_variant.survival)
+         << ",\"migration\":" << json_number(a_variant.migration)
+         << ",\"mutation\":" << json_number(a_variant.mutation)
+         << ",\"crossover\":" << json_number(a_variant.crossover)
+         << ",\"scaling\":" << (a_variant.scaling ? "true" : "false")
+         << ",\"budget\":" << a_budget
+         << ",\"target\":" << json_number(a_target)
+         << ",\"runs\":" << a_results.size()
+         << ",\"auc_mean\":" << (aucs.empty() ? "null" : json_number(auc_mean))
+         << ",\"auc_median\":" << json_number(median(aucs))
+         << ",\"auc_stddev\":" << (aucs.empty() ? "null" : json_number(sqrt(auc_var)))
+         << ",\"best_mean\":" << ((best_count == 0) ? "null" : json_number(best_sum / best_count))
+         << ",\"reached_target\":" << to_target.size()
+         << ",\"evaluations_to_target_median\":" << json_number(median(to_target))
+         << "}" << endl;
+
+    cerr << setw(28) << left << a_config << setw(20) << a_variant.name << right
+         << "  auc " << fixed << setprecision(4) << auc_mean
+         << " +/- " << sqrt(auc_var)
+         << "  best " << ((best_count == 0) ? 0.0 : best_sum / best_count)
+         << "  reached " << to_target.size() << "/" << a_results.size()
+         << "  median tests to target " << setprecision(0) << max(0.0,median(to_target))
+         << resetiosflags(ios::fixed) << setprecision(6) << endl;
+}
+
+//----------------------------------------------------------
+// display program options and command line
+void show_usage()
+{
+    cout << "usage: acovea-searchbench [options]\n\n"
+         << "   -config {config file name}              (a synthetic landscape; may be repeated;\n"
+         << "                                            default synthetic.acovea and\n"
+         << "                                            synthetic_rugged.acovea)\n"
+         << "   -variant {name:setting=value,...}       (evolutionary settings to compare; may be\n"
+         << "                                            repeated; settings are pops, size, survival,\n"
+         << "                                            migration, mutation, crossover and scaling)\n"
+         << "   -seeds {number}                         (runs of each variant, seeded 1 to n;\n"
+         << "                                            default 5)\n"
+         << "   -budget {tests}                         (fitness tests in each run; default 600)\n"
+         << "   -target {run time}                      (expected run time counted as found;\n"
+         << "                                            default 0.85, relative to -O1)\n"
+         << "   -verify                                 (reject options that compute wrong answers)\n\n"
+         << "Each run writes a line of JSON to standard output, followed by a summary line\n"
+         << "for each landscape and variant; the summaries are also shown as a table on\n"
+         << "standard error.\n\n"
+         << "example:\n"
+         << "   acovea-searchbench -seeds 5 -variant default -variant wide:pops=1,size=60\n\n";
+}
+
+//----------------------------------------------------------
+//  main program
+int main(int argc, char * argv[])
+{
+    // parse command line
+    set<string> bool_options; // empty list
+
+    command_line args(argc,argv,bool_options);
+
+    // settings
+    vector<string>  configs;
+    vector<variant> variants;
+    size_t seeds  = 5;
+    size_t budget = 600;
+    double target = 0.85;
+    bool   verify = false;
+
+    try
+    {
+        for (vector<command_line::option>::const_iterator opt = args.get_options().begin(); opt != args.get_options().end(); ++opt)
+        {
+            if (opt->m_name == "config")
+            {
+                configs.push_back(opt->m_value);
+            }
+            else if (opt->m_name == "variant")
+            {
+                variants.push_back(parse_variant(opt->m_value));
+            }
+            else if (opt->m_name == "seeds")
+            {
+                seeds = atol(opt->m_value.c_str());
+
+                if (seeds < 1)
+                    seeds = 1;
+            }
+            else if (opt->m_name == "budget")
+            {
+                budget = atol(opt->m_value.c_str());
+
+                if (budget < 1)
+                    budget = 1;
+            }
+            else if (opt->m_name == "target")
+            {
+                target = atof(opt->m_value.c_str());
+            }
+            else if (opt->m_name == "verify")
+            {
+                verify = true;
+            }
+            else if (opt->m_name == "help")
+            {
+                show_usage();
+                exit(0);
+            }
+            else
+            {
+                cout << "unknown option: " << opt->m_name << "\n\n";
+                show_usage();
+                exit(1);
+            }
+        }
+    }
+    catch (std::exception & ex)
+    {
+        cerr << "acovea-searchbench: " << ex.what() << "\n";
+        exit(1);
+    }
+
+    if (configs.empty())
+    {
+        configs.push_back("synthetic.acovea");
+        configs.push_back("synthetic_rugged.acovea");
+    }
+
+    // by default, compare fitness scaling, migration and population size
+    if (variants.empty())
+    {
+        variants.push_back(default_variant("default"));
+
+        variants.push_back(default_variant("null-scaler"));
+        variants.back().scaling = false;
+
+        variants.push_back(default_variant("no-migration"));
+        variants.back().migration = 0.0;
+
+        variants.push_back(default_variant("large-populations"));
+        variants.back().size = 40;
+    }
+
+    try
+    {
+        for (size_t c = 0; c < configs.size(); ++c)
+        {
+            double reference = baseline_time(configs[c]);
+
+            for (size_t v = 0; v < variants.size(); ++v)
+            {
+                vector<run_result> results;
+
+                for (uint32_t seed = 1; seed <= seeds; ++seed)
+                {
+                    results.push_back(run_once(configs[c],variants[v],seed,budget,target,reference,verify));
+                    report_run(configs[c],variants[v],seed,results.back());
+                }
+
+                report_summary(configs[c],variants[v],budget,target,results);
+            }
+        }
+    }
+    catch (std::exception & ex)
+    {
+        cerr << "acovea-searchbench: " << ex.what() << "\n";
+        return 1;
+    }
+
+    // outa here
+    return 0;
+}
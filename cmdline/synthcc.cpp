@@ -0,0 +1,489 @@
+//---------------------------------------------------------------------
+//  ACOVEA -- Analysis of Compiler Options Via Evolution Algorithm
+//
+//  synthcc.cpp
+//
+//  A stand-in for a compiler, for trying evolutionary settings quickly.
+//  It "compiles" by writing a tiny program that reports a run time from
+//  a synthetic fitness landscape over the options it was given: additive
+//  effects, pairwise interactions, noise, and combinations that fail to
+//  compile or compute the wrong answer. The landscape is fixed by a seed,
+//  so runs can be repeated and their results compared with -explain.
+//---------------------------------------------------------------------
+//
+//  Copyright 2003, 2004, 2005 Scott Robert Ladd
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation; either version 2 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the
+//      Free Software Foundation, Inc.
+//      59 Temple Place - Suite 330
+//      Boston, MA 02111-1307, USA.
+//
+//-----------------------------------------------------------------------
+//
+//  For more information on this software package, please visit
+//  Scott's web site, Coyote Gulch Productions, at:
+//
+//      http://www.coyotegulch.com
+//
+//-----------------------------------------------------------------------
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <limits.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <algorithm>
+using namespace std;
+
+//----------------------------------------------------------
+// display program options
+void show_usage()
+{
+    cout << "usage: acovea-synthcc [landscape] [options] -o {program} {source}\n"
+         << "       acovea-synthcc [landscape] -explain [options]\n\n"
+         << "Writes a program whose run time comes from a synthetic landscape over\n"
+         << "the options; any other argument beginning with - is an option.\n\n"
+         << "landscape:\n"
+         << "   -synth-seed=n          (which landscape; default 1)\n"
+         << "   -synth-base=seconds    (run time with no options; default 1)\n"
+         << "   -synth-active=fraction (share of options that have an effect; default 0.5)\n"
+         << "   -synth-effect=f        (largest effect of an option, as a log of the\n"
+         << "                           run time ratio; default 0.1)\n"
+         << "   -synth-pairs=fraction  (share of pairs of options that interact; default 0.05)\n"
+         << "   -synth-epistasis=f     (largest effect of a pair; default 0.05)\n"
+         << "   -synth-noise=f         (run to run variation, as a log; default 0.01)\n"
+         << "   -synth-noise-seed=n    (which noise; default 1)\n"
+         << "   -synth-fail=fraction   (share of pairs that don't compile; default 0)\n"
+         << "   -synth-wrong=fraction  (share of pairs that compute the wrong answer;\n"
+         << "                           default 0)\n\n"
+         << "-explain lists the effect of each option and interacting pair, and the\n"
+         << "expected run time of the options together.\n";
+}
+
+//----------------------------------------------------------
+// the landscape
+struct landscape
+{
+    uint64_t m_seed;
+    double   m_base;
+    double   m_active;
+    double   m_effect;
+    double   m_pairs;
+    double   m_epistasis;
+    double   m_noise;
+    uint64_t m_noise_seed;
+    double   m_fail;
+    double   m_wrong;
+};
+
+// checksum of a correct result
+static const double RIGHT_CHECKSUM = 271828.18284590452;
+
+// program size with no options
+static const double BASE_SIZE = 8192.0;
+
+// a number in [0,1) that depends only on the seed and some text
+static double hash_unit(uint64_t a_seed, const string & a_domain, const string & a_text)
+{
+    // FNV-1a, then a final mix
+    uint64_t hash = 14695981039346656037ULL ^ a_seed;
+    string text = a_domain + "\n" + a_text;
+
+    for (size_t n = 0; n < text.size(); ++n)
+    {
+        hash ^= static_cast<unsigned char>(text[n]);
+        hash *= 1099511628211ULL;
+    }
+
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+
+    return static_cast<double>(hash >> 11) / 9007199254740992.0;
+}
+
+// an option's name, without any value
+static string option_name(const string & a_option)
+{
+    return a_option.substr(0,a_option.find('='));
+}
+
+// effect of an option on the log of run time (or size); an option with a
+//   value has a best value, with effects falling off on either side
+static double option_effect(const landscape & a_land, const string & a_domain, const string & a_option)
+{
+    string name = option_name(a_option);
+
+    if (hash_unit(a_land.m_seed,a_domain + " active",name) >= a_land.m_active)
+        return 0.0;
+
+    double effect = a_land.m_effect * (2.0 * hash_unit(a_land.m_seed,a_domain,name) - 1.0);
+
+    if (name.size() < a_option.size())
+    {
+        double value = atof(a_option.c_str() + name.size() + 1);
+        double best  = pow(2.0,12.0 * hash_unit(a_land.m_seed,a_domain + " best",name));
+        double miss  = log((value > 1.0 ? value : 1.0) / best) / log(2.0);
+        effect *= exp(-miss * miss / 8.0);
+    }
+
+    return effect;
+}
+
+// a pair of options, by name and in order
+static string pair_key(const string & a_first, const string & a_second)
+{
+    string first  = option_name(a_first);
+    string second = option_name(a_second);
+    return (first < second) ? (first + " " + second) : (second + " " + first);
+}
+
+// effect of a pair of options on the log of run time
+static double pair_effect(const landscape & a_land, const string & a_first, const string & a_second)
+{
+    string key = pair_key(a_first,a_second);
+
+    if (hash_unit(a_land.m_seed,"pair",key) >= a_land.m_pairs)
+        return 0.0;
+
+    return a_land.m_epistasis * (2.0 * hash_unit(a_land.m_seed,"pair effect",key) - 1.0);
+}
+
+// does a pair of options fail to compile, or compute the wrong answer?
+static bool pair_fails(const landscape & a_land, const string & a_first, const string & a_second)
+{
+    return hash_unit(a_land.m_seed,"fail",pair_key(a_first,a_second)) < a_land.m_fail;
+}
+
+static bool pair_wrong(const landscape & a_land, const string & a_first, const string & a_second)
+{
+    return hash_unit(a_land.m_seed,"wrong",pair_key(a_first,a_second)) < a_land.m_wrong;
+}
+
+// what a set of options compiles to
+struct outcome
+{
+    double m_time;
+    double m_size;
+    double m_checksum;
+    string m_failure;   // empty if it compiles
+};
+
+static outcome evaluate(const landscape & a_land, const vector<string> & a_options, bool a_explain)
+{
+    outcome result = { 0.0, 0.0, RIGHT_CHECKSUM, string() };
+    double log_time = 0.0;
+    double log_size = 0.0;
+
+    for (size_t i = 0; i < a_options.size(); ++i)
+    {
+        double effect = option_effect(a_land,"time",a_options[i]);
+        log_time += effect;
+        log_size += option_effect(a_land,"size",a_options[i]);
+
+        if (a_explain)
+            cout << left << setw(40) << a_options[i] << " " << showpos << effect << noshowpos << "\n";
+    }
+
+    for (size_t i = 0; i < a_options.size(); ++i)
+    {
+        for (size_t j = i + 1; j < a_options.size(); ++j)
+        {
+            double effect = pair_effect(a_land,a_options[i],a_options[j]);
+            log_time += effect;
+
+            if (pair_fails(a_land,a_options[i],a_options[j]) && result.m_failure.empty())
+                result.m_failure = a_options[i] + " and " + a_options[j] + " don't mix";
+
+            if (pair_wrong(a_land,a_options[i],a_options[j]))
+                result.m_checksum += 1.0;
+
+            if (a_explain && ((effect != 0.0) || pair_fails(a_land,a_options[i],a_options[j]) || pair_wrong(a_land,a_options[i],a_options[j])))
+            {
+                cout << left << setw(40) << (a_options[i] + " " + a_options[j]) << " " << showpos << effect << noshowpos;
+
+                if (pair_fails(a_land,a_options[i],a_options[j]))
+                    cout << " (fails to compile)";
+
+                if (pair_wrong(a_land,a_options[i],a_options[j]))
+                    cout << " (wrong answer)";
+
+                cout << "\n";
+            }
+        }
+    }
+
+    result.m_time = a_land.m_base * exp(log_time);
+    result.m_size = BASE_SIZE * exp(log_size);
+    return result;
+}
+
+//----------------------------------------------------------
+// the compiled program
+
+// a normally distributed random number
+static double random_normal()
+{
+    double u1 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    double u2 = (rand() + 1.0) / (RAND_MAX + 2.0);
+    return sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2);
+}
+
+// counts runs of a program, in a fixed-width field of the program itself,
+//   so the count goes away with the program
+static const char   RUNS_FIELD[] = "\n#runs=";
+static const size_t RUNS_WIDTH   = 10;
+
+// the number of earlier runs of a program, counting this one
+static unsigned long count_run(const char * a_program)
+{
+    FILE * program = fopen(a_program,"r+");
+
+    if (program == NULL)
+        return 0;
+
+    char header[PATH_MAX + 256];
+    size_t length = fread(header,1,sizeof(header) - 1,program);
+    header[length] = '\0';
+
+    unsigned long runs = 0;
+    const char * field = strstr(header,RUNS_FIELD);
+
+    if (field != NULL)
+    {
+        field += strlen(RUNS_FIELD);
+        runs = strtoul(field,NULL,10);
+
+        if (fseek(program,field - header,SEEK_SET) == 0)
+            fprintf(program,"%0*lu",static_cast<int>(RUNS_WIDTH),runs + 1);
+    }
+
+    fclose(program);
+    return runs;
+}
+
+// report one run, as a benchmark would; the noise depends only on the
+//   noise seed, the program, the scale, and how many times it has run
+static void report_run(double a_time, double a_noise, double a_checksum, double a_scale,
+                       uint64_t a_noise_seed, unsigned long a_run)
+{
+    char run[128];
+    snprintf(run,sizeof(run),"%.17g %.17g %lu",a_time,a_scale,a_run);
+    srand(static_cast<unsigned int>(hash_unit(a_noise_seed,"noise",run) * 4294967296.0));
+
+    double time = a_time * a_scale * exp(a_noise * random_normal());
+    printf("acovea-result/1 time=%f expected=%f checksum=%.17g scale=%g\n",time,a_time * a_scale,a_checksum,a_scale);
+    fflush(stdout);
+}
+
+// run as the compiled program: arguments are the expected run time, the
+//   noise, the checksum, the noise seed, and the program, then the
+//   arguments of a benchmark
+static int run_program(int argc, char ** argv)
+{
+    if (argc < 7)
+        return 1;
+
+    double   time       = atof(argv[2]);
+    double   noise      = atof(argv[3]);
+    double   checksum   = atof(argv[4]);
+    uint64_t noise_seed = strtoull(argv[5],NULL,10);
+    const char * self   = argv[6];
+    double   scale      = 1.0;
+    bool     serve      = false;
+
+    for (int n = 7; n < argc; ++n)
+    {
+        if (!strcmp(argv[n],"-scale") && (n + 1 < argc))
+            scale = atof(argv[++n]);
+        else if (!strcmp(argv[n],"-fork-server"))
+            serve = true;
+    }
+
+    if ((scale <= 0.0) || (scale > 1.0))
+        scale = 1.0;
+
+    // serve runs to ACOVEA, as benchmarks/benchharness.h does
+    static const int CONTROL_FD = 198;
+    static const int STATUS_FD  = 199;
+    static const char hello[4]  = { 'A', 'F', 'S', '1' };
+
+    if (serve && (write(STATUS_FD,hello,sizeof(hello)) == sizeof(hello)))
+    {
+        uint32_t request;
+
+        while (read(CONTROL_FD,&request,sizeof(request)) == sizeof(request))
+        {
+            int32_t status = -1;
+            pid_t   pid    = fork();
+
+            if (pid == 0)
+            {
+                report_run(time,noise,checksum,scale,noise_seed,count_run(self));
+                _exit(0);
+            }
+
+            if (pid > 0)
+                waitpid(pid,&status,0);
+
+            if (write(STATUS_FD,&status,sizeof(status)) != sizeof(status))
+                break;
+        }
+
+        return 0;
+    }
+
+    report_run(time,noise,checksum,scale,noise_seed,count_run(self));
+    return 0;
+}
+
+// write the program, a script that runs this one; it is padded to the
+//   synthetic size, for size optimization
+static bool write_program(const string & a_name, const outcome & a_result, const landscape & a_land)
+{
+    char self[PATH_MAX];
+    ssize_t length = readlink("/proc/self/exe",self,sizeof(self) - 1);
+
+    if (length <= 0)
+        return false;
+
+    self[length] = '\0';
+
+    ofstream program(a_name.c_str());
+    program << "#!/bin/sh\nexec '" << self << "' -synth-run " << setprecision(17)
+            << a_result.m_time << " " << a_land.m_noise << " " << a_result.m_checksum << " "
+            << a_land.m_noise_seed << " \"$0\" \"$@\"" << RUNS_FIELD << string(RUNS_WIDTH,'0') << "\n#";
+
+    long padding = static_cast<long>(a_result.m_size) - static_cast<long>(program.tellp());
+
+    if (padding > 0)
+        program << string(padding,'#');
+
+    program << "\n";
+
+    if (!program)
+        return false;
+
+    program.close();
+    return chmod(a_name.c_str(),0755) == 0;
+}
+
+//----------------------------------------------------------
+// main program
+int main(int argc, char ** argv)
+{
+    if ((argc > 1) && !strcmp(argv[1],"-synth-run"))
+        return run_program(argc,argv);
+
+    landscape land = { 1, 1.0, 0.5, 0.1, 0.05, 0.05, 0.01, 1, 0.0, 0.0 };
+    vector<string> options;
+    string output_name;
+    bool   explain = false;
+
+    for (int n = 1; n < argc; ++n)
+    {
+        string arg(argv[n]);
+
+        if (arg.compare(0,12,"-synth-seed=") == 0)
+            land.m_seed = strtoull(argv[n] + 12,NULL,10);
+        else if (arg.compare(0,12,"-synth-base=") == 0)
+            land.m_base = atof(argv[n] + 12);
+        else if (arg.compare(0,14,"-synth-active=") == 0)
+            land.m_active = atof(argv[n] + 14);
+        else if (arg.compare(0,14,"-synth-effect=") == 0)
+            land.m_effect = atof(argv[n] + 14);
+        else if (arg.compare(0,13,"-synth-pairs=") == 0)
+            land.m_pairs = atof(argv[n] + 13);
+        else if (arg.compare(0,17,"-synth-epistasis=") == 0)
+            land.m_epistasis = atof(argv[n] + 17);
+        else if (arg.compare(0,13,"-synth-noise=") == 0)
+            land.m_noise = atof(argv[n] + 13);
+        else if (arg.compare(0,18,"-synth-noise-seed=") == 0)
+            land.m_noise_seed = strtoull(argv[n] + 18,NULL,10);
+        else if (arg.compare(0,12,"-synth-fail=") == 0)
+            land.m_fail = atof(argv[n] + 12);
+        else if (arg.compare(0,13,"-synth-wrong=") == 0)
+            land.m_wrong = atof(argv[n] + 13);
+        else if (arg == "-explain")
+            explain = true;
+        else if ((arg == "-o") && (n + 1 < argc))
+            output_name = argv[++n];
+        else if (arg == "-dumpversion")
+        {
+#if defined(ACOVEA_VERSION)
+            cout << ACOVEA_VERSION << "\n";
+#else
+            cout << "synthetic\n";
+#endif
+            return 0;
+        }
+        else if ((arg == "-help") || (arg == "--help"))
+        {
+            show_usage();
+            return 0;
+        }
+        else if ((arg.size() > 1) && (arg[0] == '-'))
+            options.push_back(arg);
+    }
+
+    // the order of options doesn't matter
+    sort(options.begin(),options.end());
+
+    outcome result = evaluate(land,options,explain);
+
+    if (explain)
+    {
+        cout << "expected run time: " << result.m_time << "\n"
+             << "size: " << static_cast<long>(result.m_size) << " bytes\n";
+
+        if (!result.m_failure.empty())
+            cout << "fails to compile: " << result.m_failure << "\n";
+
+        if (result.m_checksum != RIGHT_CHECKSUM)
+            cout << "computes the wrong answer\n";
+
+        return 0;
+    }
+
+    if (output_name.empty())
+    {
+        show_usage();
+        return 1;
+    }
+
+    if (!result.m_failure.empty())
+    {
+        cerr << "acovea-synthcc: internal compiler error: " << result.m_failure << "\n";
+        return 1;
+    }
+
+    if (!write_program(output_name,result,land))
+    {
+        cerr << "acovea-synthcc: unable to write " << output_name << "\n";
+        return 1;
+    }
+
+    return 0;
+}
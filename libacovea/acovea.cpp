@@ -42,23 +42,115 @@ using namespace libcoyotl;
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <signal.h>
+#include <ftw.h>
 #include <sys/types.h>
 #include <sys/wait.h>
 #include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <arpa/inet.h>
+#include <elf.h>
 
 #include <vector>
+#include <cmath>
+#include <cerrno>
 #include <cstring>
 #include <sstream>
+#include <fstream>
 #include <iostream>
 #include <iomanip>
 #include <stdexcept>
+#include <algorithm>
+#include <limits>
+#include <cctype>
+#include <climits>
 using namespace std;
 
 // the expat XML parsing library
 #include "expat.h"
 
-// global constant
-static const double BOGUS_RUN_TIME = 1000000000.0;
+// binary I/O for checkpoints
+template <typename T>
+static void write_value(FILE * a_file, const T & a_value)
+{
+    if (fwrite(&a_value,sizeof(T),1,a_file) != 1)
+        throw runtime_error("unable to write checkpoint");
+}
+
+template <typename T>
+static T read_value(FILE * a_file)
+{
+    T value;
+
+    if (fread(&value,sizeof(T),1,a_file) != 1)
+        throw runtime_error("checkpoint is truncated");
+
+    return value;
+}
+
+// elapsed wall-clock time, in seconds
+static double wall_seconds()
+{
+    struct timeval now;
+    gettimeofday(&now,NULL);
+    return static_cast<double>(now.tv_sec) + static_cast<double>(now.tv_usec) / 1000000.0;
+}
+
+//----------------------------------------------------------
+// settings for an ACOVEA run
+
+// constructor (sets defaults)
+run_settings::run_settings()
+  : m_use_cache(true),
+    m_cache_code_only(true),
+    m_cache_refine(3),
+    m_use_surrogate(false),
+    m_surrogate_screen(4),
+    m_surrogate_explore(0.25),
+    m_jobs(1),
+    m_repeats(3),
+    m_fork_server(false),
+    m_fidelity_scale(0.0),
+    m_fidelity_promote(1.0 / 3.0),
+    m_verify(false),
+    m_verify_tolerance(1e-9),
+    m_polish(false),
+    m_ablation(false),
+    m_checkpoint_file(),
+    m_checkpoint_every(1),
+    m_checkpoint_minutes(0.0),
+    m_resume_file(),
+    m_island_address(),
+    m_island_peers(),
+    m_steady_state(false),
+    m_max_evaluations(0),
+    m_max_minutes(0.0),
+    m_target_ratio(0.0),
+    m_stall_generations(0),
+    m_stall_epsilon(0.001),
+    m_budget_reserve(0.1),
+    m_adaptive_rates(false),
+    m_diversity_low(0.1),
+    m_diversity_high(0.3),
+    m_unique_children(false),
+    m_unique_history(false),
+    m_unique_retries(8),
+    m_seed_baselines(false),
+    m_seed_file(),
+    m_seed_fraction(0.25),
+    m_seed_mutation(0.05),
+    m_save_seeds_file(),
+    m_report_timing(false),
+    m_timing_file(),
+    m_trace_file(),
+    m_polish_passes(5),
+    m_polish_threshold(0.01)
+{
+    // nada
+}
 
 //----------------------------------------------------------
 // abstract definition of a application option or switch
@@ -487,6 +579,380 @@ chromosome::~chromosome()
         delete *opt;
 }
 
+//----------------------------------------------------------
+// benchmark results
+
+// marks a version 1 result line
+static const char RESULT_TAG[] = "acovea-result/";
+
+// constructor
+benchmark_result::benchmark_result()
+  : m_fields(),
+    m_version(-1)
+{
+    // nada
+}
+
+// read key=value fields from a line
+void benchmark_result::parse_fields(const string & a_line, size_t a_start)
+{
+    istringstream tokens(a_line.substr(a_start));
+    string token;
+
+    while (tokens >> token)
+    {
+        string::size_type equals = token.find('=');
+
+        // anything that isn't a field is ignored
+        if ((equals != string::npos) && (equals > 0))
+            m_fields[token.substr(0,equals)] = token.substr(equals + 1);
+    }
+}
+
+// read the output of a benchmark
+bool benchmark_result::parse(const string & a_output)
+{
+    m_fields.clear();
+    m_version = -1;
+
+    // look for the last versioned result line
+    string result_line;
+    string first_line;
+    bool   first = true;
+    istringstream lines(a_output);
+    string line;
+
+    while (getline(lines,line))
+    {
+        if (first)
+        {
+            first_line = line;
+            first = false;
+        }
+
+        string::size_type start = line.find_first_not_of(" \t");
+
+        if ((start != string::npos) && (0 == line.compare(start,sizeof(RESULT_TAG) - 1,RESULT_TAG)))
+            result_line = line.substr(start);
+    }
+
+    if (!result_line.empty())
+    {
+        string::size_type end = result_line.find_first_of(" \t");
+        int version = atoi(result_line.substr(sizeof(RESULT_TAG) - 1,end).c_str());
+
+        // later versions may mean something different by the same fields
+        if (version != 1)
+            return false;
+
+        m_version = version;
+        parse_fields(result_line,(end == string::npos) ? result_line.size() : end);
+        return true;
+    }
+
+    // otherwise, the classic run time on the first line
+    const char * text = first_line.c_str();
+    char * end = NULL;
+    strtod(text,&end);
+
+    if (end == text)
+        return false;
+
+    m_version = 0;
+    m_fields["time"] = string(text,end - text).substr(first_line.find_first_not_of(" \t"));
+    parse_fields(first_line,end - text);
+    return true;
+}
+
+// get a numeric field
+bool benchmark_result::get_metric(const string & a_name, double & a_value) const
+{
+    map<string,string>::const_iterator field = m_fields.find(a_name);
+
+    if (field == m_fields.end())
+        return false;
+
+    const char * text = field->second.c_str();
+    char * end = NULL;
+    double value = strtod(text,&end);
+
+    // NaN and infinity aren't measurements
+    if ((end == text) || (*end != 0) || (value != value) || (fabs(value) > numeric_limits<double>::max()))
+        return false;
+
+    a_value = value;
+    return true;
+}
+
+//----------------------------------------------------------
+// fitness from benchmark metrics
+
+// constructor
+fitness_formula::fitness_formula()
+  : m_terms(),
+    m_default(true)
+{
+    m_terms.push_back(make_pair(string("time"),1.0));
+}
+
+// constructor from text
+fitness_formula::fitness_formula(const string & a_text)
+  : m_terms(),
+    m_default(true)
+{
+    m_terms.push_back(make_pair(string("time"),1.0));
+
+    istringstream terms(a_text);
+    string term;
+
+    while (getline(terms,term,','))
+    {
+        string::size_type colon = term.find(':');
+        string name = term.substr(0,colon);
+        double weight = 1.0;
+
+        if (colon != string::npos)
+        {
+            const char * text = term.c_str() + colon + 1;
+            char * end = NULL;
+            weight = strtod(text,&end);
+
+            if ((end == text) || (*end != 0))
+                throw runtime_error("invalid weight in fitness metric: " + term);
+        }
+
+        if (name.empty())
+            throw runtime_error("missing name in fitness metric: " + term);
+
+        add_term(name,weight);
+    }
+}
+
+// add a weighted metric
+void fitness_formula::add_term(const string & a_metric, double a_weight)
+{
+    if (m_default)
+    {
+        m_terms.clear();
+        m_default = false;
+    }
+
+    if (!(a_weight > 0.0))
+        throw runtime_error("fitness metric weights must be positive: " + a_metric);
+
+    m_terms.push_back(make_pair(a_metric,a_weight));
+}
+
+// compute fitness
+bool fitness_formula::evaluate(const benchmark_result & a_result,
+                               double & a_fitness,
+                               string & a_missing) const
+{
+    double fitness = 0.0;
+
+    for (size_t n = 0; n < m_terms.size(); ++n)
+    {
+        // "1/name" is the reciprocal, for metrics where more is better
+        const string & name = m_terms[n].first;
+        bool reciprocal = (0 == name.compare(0,2,"1/"));
+        double value;
+
+        if (!a_result.get_metric(reciprocal ? name.substr(2) : name,value) || (reciprocal && (value == 0.0)))
+        {
+            a_missing = name;
+            return false;
+        }
+
+        if (reciprocal)
+            value = 1.0 / value;
+
+        fitness += m_terms[n].second * value;
+    }
+
+    a_fitness = fitness;
+    return true;
+}
+
+// description for the configuration report
+string fitness_formula::get_description() const
+{
+    ostringstream text;
+
+    for (size_t n = 0; n < m_terms.size(); ++n)
+    {
+        double weight = m_terms[n].second;
+
+        if (n > 0)
+            text << " + ";
+
+        if (weight != 1.0)
+            text << weight << " ";
+
+        text << m_terms[n].first;
+    }
+
+    return text.str();
+}
+
+//----------------------------------------------------------
+// weighted benchmark programs
+
+// constructor from text
+benchmark_suite::benchmark_suite(const string & a_text)
+  : m_inputs(),
+    m_weights(),
+    m_baselines(),
+    m_checksums(),
+    m_tolerance(0.0)
+{
+    istringstream inputs(a_text);
+    string input;
+
+    while (getline(inputs,input,','))
+    {
+        string::size_type colon = input.rfind(':');
+        string name = input.substr(0,colon);
+        double weight = 1.0;
+
+        if (colon != string::npos)
+        {
+            const char * text = input.c_str() + colon + 1;
+            char * end = NULL;
+            weight = strtod(text,&end);
+
+            if ((end == text) || (*end != 0) || !(weight > 0.0))
+                throw runtime_error("invalid weight for input: " + input);
+        }
+
+        if (name.empty())
+            throw runtime_error("missing name for input: " + input);
+
+        m_inputs.push_back(name);
+        m_weights.push_back(weight);
+        m_baselines.push_back(1.0);
+        m_checksums.push_back(string());
+    }
+
+    if (m_inputs.empty())
+        throw runtime_error("no input given");
+}
+
+// set the fitness an input is normalized to
+void benchmark_suite::set_baseline(size_t a_index, double a_fitness)
+{
+    // an input without a usable baseline is not normalized
+    m_baselines[a_index] = ((a_fitness > 0.0) && (a_fitness != BOGUS_RUN_TIME)) ? a_fitness : 1.0;
+}
+
+// combine fitness on each input
+double benchmark_suite::combine(const vector<double> & a_fitness) const
+{
+    if (find(a_fitness.begin(),a_fitness.end(),BOGUS_RUN_TIME) != a_fitness.end())
+        return BOGUS_RUN_TIME;
+
+    if (!is_combined())
+        return a_fitness[0];
+
+    double total_weight = 0.0;
+    double log_sum      = 0.0;
+    double sum          = 0.0;
+    bool   positive     = true;
+
+    for (size_t n = 0; n < m_inputs.size(); ++n)
+    {
+        double ratio  = a_fitness[n] / m_baselines[n];
+        total_weight += m_weights[n];
+        sum          += m_weights[n] * ratio;
+
+        if (ratio > 0.0)
+            log_sum += m_weights[n] * log(ratio);
+        else
+            positive = false;
+    }
+
+    // a geometric mean needs positive values (return codes may not be)
+    return positive ? exp(log_sum / total_weight) : (sum / total_weight);
+}
+
+// description for the configuration report
+string benchmark_suite::get_description() const
+{
+    if (!is_combined())
+        return m_inputs[0];
+
+    ostringstream text;
+
+    for (size_t n = 0; n < m_inputs.size(); ++n)
+        text << ((n > 0) ? ", " : "") << m_inputs[n] << " (weight " << m_weights[n] << ")";
+
+    return text.str();
+}
+
+// set the relative difference allowed between checksums that are numbers
+void benchmark_suite::set_tolerance(double a_tolerance)
+{
+    m_tolerance = a_tolerance;
+}
+
+// set the checksum results on an input must agree with
+void benchmark_suite::set_checksum(size_t a_index, const string & a_checksum)
+{
+    m_checksums[a_index] = a_checksum;
+}
+
+// do the fields of a result agree with an input's checksum?
+bool benchmark_suite::verify(size_t a_index, const map<string,string> & a_fields) const
+{
+    const string & expected = m_checksums[a_index];
+
+    if (expected.empty())
+        return true;
+
+    map<string,string>::const_iterator field = a_fields.find("checksum");
+
+    if (field == a_fields.end())
+        return false;
+
+    const string & checksum = field->second;
+
+    if (checksum == expected)
+        return true;
+
+    // hexadecimal checksums are hashes, which must match exactly
+    if ((0 == checksum.compare(0,2,"0x")) || (0 == expected.compare(0,2,"0x")))
+        return false;
+
+    char * end = NULL;
+    double value = strtod(checksum.c_str(),&end);
+
+    if ((end == checksum.c_str()) || (*end != 0))
+        return false;
+
+    double reference = strtod(expected.c_str(),&end);
+
+    if ((end == expected.c_str()) || (*end != 0))
+        return false;
+
+    return fabs(value - reference) <= m_tolerance * max(fabs(value),fabs(reference));
+}
+
+// baselines and checksums, as text
+string benchmark_suite::get_baseline_text() const
+{
+    ostringstream text;
+
+    for (size_t n = 0; n < m_inputs.size(); ++n)
+    {
+        if (is_combined())
+            text << "baseline fitness for " << m_inputs[n] << ": " << m_baselines[n] << "\n";
+
+        if (!m_checksums[n].empty())
+            text << "reference checksum for " << m_inputs[n] << ": " << m_checksums[n] << "\n";
+    }
+
+    return text.str();
+}
+
 //----------------------------------------------------------
 // the definition of a application
 
@@ -513,6 +979,7 @@ void application::import_element(const char * element, const char ** attr)
     int maxval  = 0;
     int stepval = 0;
     char sep    = '=';
+    bool profile = false;
     
     if (0 == strcmp(element,"description"))
     {
@@ -557,6 +1024,20 @@ void application::import_element(const char * element, const char ** attr)
                 m_prime.m_flags = attr[i + 1];
         }
     }
+    else if (0 == strcmp(element,"profile"))
+    {
+        m_profile.m_description = "Profile";
+
+        for (i = 0; attr[i] != NULL; i += 2)
+        {
+            if (0 == strcmp(attr[i],"command"))
+                m_profile.m_command = attr[i + 1];
+            else if (0 == strcmp(attr[i],"flags"))
+                m_profile.m_flags = attr[i + 1];
+            else if (0 == strcmp(attr[i],"scale"))
+                m_profile_scale = atof(attr[i + 1]);
+        }
+    }
     else if (0 == strcmp(element,"baseline"))
     {
         command_elements baseline;
@@ -573,6 +1054,34 @@ void application::import_element(const char * element, const char ** attr)
         
         m_baselines.push_back(baseline);
     }
+    else if (0 == strcmp(element,"metric"))
+    {
+        string name;
+        double weight = 1.0;
+
+        for (i = 0; attr[i] != NULL; i += 2)
+        {
+            if (0 == strcmp(attr[i],"name"))
+                name = attr[i + 1];
+            else if (0 == strcmp(attr[i],"weight"))
+            {
+                char * end = NULL;
+                weight = strtod(attr[i + 1],&end);
+
+                // remember the problem; exceptions can't cross the parser
+                if ((end == attr[i + 1]) || (*end != 0) || !(weight > 0.0))
+                {
+                    if (m_config_error.empty())
+                        m_config_error = string("invalid weight in fitness metric: ") + attr[i + 1];
+
+                    return;
+                }
+            }
+        }
+
+        if (!name.empty())
+            m_fitness.add_term(name,weight);
+    }
     else if (0 == strcmp(element,"flag"))
     {
         // search attributes
@@ -592,10 +1101,16 @@ void application::import_element(const char * element, const char ** attr)
                 stepval = atoi(attr[i + 1]);
             else if (0 == strcmp(attr[i],"separator"))
                 sep = attr[i + 1][0];
+            else if (0 == strcmp(attr[i],"profile"))
+                profile = (0 == strcmp(attr[i + 1],"true"));
         }
         
         if ((value != NULL) && (type != NULL))
         {
+            // this option is also given to the instrumented build
+            if (profile)
+                m_profile_options.push_back(m_options.size());
+
             if (0 == strcmp(type,"simple"))
                 m_options.push_back(new simple_option(value,false));
             else if (0 == strcmp(type,"enum"))
@@ -616,7 +1131,14 @@ application::application(const string & a_config_name)
     m_prime(),
     m_baselines(),
     m_description(),
-    m_options()
+    m_options(),
+    m_fitness(),
+    m_profile(),
+    m_profile_scale(1.0),
+    m_profile_options(),
+    m_functions(),
+    m_function_options(),
+    m_config_error()
 {
     // create an XML parser
 	XML_Parser parser = XML_ParserCreate(NULL); 
@@ -671,6 +1193,10 @@ application::application(const string & a_config_name)
     
     // release memory
     delete [] xml_buffer;
+
+    // report anything the handlers found wrong
+    if (!m_config_error.empty())
+        throw runtime_error(m_config_error);
 }
 
 // copy constructor
@@ -679,7 +1205,14 @@ application::application(const application & a_source)
     m_prime(a_source.m_prime),
     m_baselines(a_source.m_baselines),
     m_description(a_source.m_description),
-    m_options(a_source.m_options)
+    m_options(a_source.m_options),
+    m_fitness(a_source.m_fitness),
+    m_profile(a_source.m_profile),
+    m_profile_scale(a_source.m_profile_scale),
+    m_profile_options(a_source.m_profile_options),
+    m_functions(a_source.m_functions),
+    m_function_options(a_source.m_function_options),
+    m_config_error(a_source.m_config_error)
 {
     // nada
 }
@@ -696,6 +1229,13 @@ application & application::operator = (const application & a_source)
     m_baselines   = a_source.m_baselines;
     m_description = a_source.m_description;
     m_options     = a_source.m_options;
+    m_fitness     = a_source.m_fitness;
+    m_profile     = a_source.m_profile;
+    m_profile_scale   = a_source.m_profile_scale;
+    m_profile_options = a_source.m_profile_options;
+    m_functions        = a_source.m_functions;
+    m_function_options = a_source.m_function_options;
+    m_config_error     = a_source.m_config_error;
 
     return *this;
 }
@@ -794,18 +1334,32 @@ vector<string> application::get_get_app_version() const
     return command;
 }
 
+// get the metrics that make up fitness
+const fitness_formula & application::get_fitness() const
+{
+    return m_fitness;
+}
+
+// set the metrics that make up fitness
+void application::set_fitness(const fitness_formula & a_fitness)
+{
+    m_fitness = a_fitness;
+}
+
 // return an argument list for compiling a given program
 vector<string> application::get_prime_command(const string &     a_input_name,
                                               const string &     a_output_name,
-                                              const chromosome & a_options) const
+                                              const chromosome & a_options,
+                                              const string &     a_profile_dir) const
 {
-    return get_command(m_prime,a_input_name,a_output_name,a_options);
+    return get_command(m_prime,a_input_name,a_output_name,a_options,a_profile_dir);
 }
 
 vector<string> application::get_command(const command_elements & a_elements,
                                         const string &           a_input_name,
                                         const string &           a_output_name,
-                                        const chromosome &       a_options) const
+                                        const chromosome &       a_options,
+                                        const string &           a_profile_dir) const
 {
     // start with the command head
     vector<string> command;
@@ -817,6 +1371,10 @@ vector<string> application::get_command(const command_elements & a_elements,
     static const string ACOVEA_INPUT("ACOVEA_INPUT");
     static const string ACOVEA_OUTPUT("ACOVEA_OUTPUT");
     static const string ACOVEA_OPTIONS("ACOVEA_OPTIONS");
+    static const string ACOVEA_PROFILE("ACOVEA_PROFILE");
+
+    // options of tuned functions go in the source, not the command
+    int global_options = static_cast<int>(min(a_options.size(),get_global_option_count()));
     
     char * v = strdup(a_elements.m_flags.c_str());
     char * token = strtok(v," ");
@@ -835,6 +1393,11 @@ vector<string> application::get_command(const command_elements & a_elements,
         if (pos != string::npos)
             token_s.replace(pos,ACOVEA_OUTPUT.length(),a_output_name);
 
+        // without a profile, as in a displayed command, the token stays
+        pos = token_s.find(ACOVEA_PROFILE);
+        if ((pos != string::npos) && !a_profile_dir.empty())
+            token_s.replace(pos,ACOVEA_PROFILE.length(),a_profile_dir);
+
         pos = token_s.find(ACOVEA_OPTIONS);
         if (pos != string::npos)
         {
@@ -842,7 +1405,7 @@ vector<string> application::get_command(const command_elements & a_elements,
             {
                 string options;
 
-                for (int n = 0; n < a_options.size(); ++n)
+                for (int n = 0; n < global_options; ++n)
                 {
                     if (a_options[n]->is_enabled())
                         options += a_options[n]->get() + " ";
@@ -855,7 +1418,7 @@ vector<string> application::get_command(const command_elements & a_elements,
             }
             else
             {
-                for (int n = 0; n < a_options.size(); ++n)
+                for (int n = 0; n < global_options; ++n)
                 {
                     
                     if (a_options[n]->is_enabled())
@@ -878,56 +1441,416 @@ vector<string> application::get_command(const command_elements & a_elements,
     return command;
 }
 
-// get a random set of options for this application
-chromosome application::get_random_options() const
+// return an argument list for an instrumented build
+vector<string> application::get_profile_command(const string &     a_input_name,
+                                                const string &     a_output_name,
+                                                const chromosome & a_options,
+                                                const string &     a_profile_dir) const
 {
-    int n;
-    
-    // result
-    chromosome options;
-    
-    // push_back options
-    for (n = 0; n < m_options.size(); ++n)
-        options.push_back(m_options[n]->clone());
-    
-    for (n = 0; n < m_options.size(); ++n)
-	    options[n]->randomize();
-    
-    // done
-    return options;
+    chromosome instrumented;
+
+    for (size_t n = 0; n < m_profile_options.size(); ++n)
+        instrumented.push_back(a_options[m_profile_options[n]]->clone());
+
+    return get_command(m_profile,a_input_name,a_output_name,instrumented,a_profile_dir);
 }
 
-// breed a new options set from two parents
-chromosome application::breed(const chromosome & a_parent1,
-                           const chromosome & a_parent2) const
+// the options that affect instrumentation, as text
+string application::get_profile_key(const chromosome & a_options) const
 {
-    // This function assumes that the two lists are the same length, and
-    // contain the same list of options in the same order
-    if (a_parent1.size() != a_parent2.size())
-    {
-        char message[128];
-        snprintf(message,128,"incompatible option vectors in breeding (sizes %lu and %lu)",a_parent1.size(),a_parent2.size());
-        throw invalid_argument(message);
-    }
-    
-    // result
-    chromosome child;
-    
-    // randomly pick an option from one of the parents
-    for (int n = 0; n < a_parent1.size(); ++n)
+    string key;
+
+    for (size_t n = 0; n < m_profile_options.size(); ++n)
     {
-        if (g_random.get_real() < 0.5)
-            child.push_back(a_parent1[n]->clone());
-        else
-            child.push_back(a_parent2[n]->clone());
+        if (a_options[m_profile_options[n]]->is_enabled())
+            key += a_options[m_profile_options[n]]->get() + " ";
     }
-    
-    // done
-    return child;
+
+    return key;
 }
 
-// mutate an option set
-void application::mutate(chromosome & a_options,
+// can an option be set for a single function? GCC's optimize pragma
+//   takes -f and -O options
+static bool is_function_option(const option * a_option)
+{
+    vector<string> choices = a_option->get_choices();
+
+    for (size_t n = 0; n < choices.size(); ++n)
+    {
+        if ((choices[n].compare(0,2,"-f") != 0) && (choices[n].compare(0,2,"-O") != 0))
+            return false;
+    }
+
+    return !choices.empty();
+}
+
+// tune functions separately
+void application::set_functions(const vector<string> & a_functions)
+{
+    if (!m_functions.empty())
+        throw runtime_error("functions are already tuned separately");
+
+    size_t global_options = m_options.size();
+
+    for (size_t n = 0; n < global_options; ++n)
+    {
+        if (is_function_option(m_options[n]))
+            m_function_options.push_back(n);
+    }
+
+    if (m_function_options.empty())
+        throw runtime_error("the configuration has no options that can be set for a function");
+
+    // a function starts out with no options of its own
+    for (size_t f = 0; f < a_functions.size(); ++f)
+    {
+        for (size_t n = 0; n < m_function_options.size(); ++n)
+        {
+            option * gene = m_options[m_function_options[n]]->clone();
+            gene->set_enabled(false);
+            m_options.push_back(gene);
+        }
+    }
+
+    m_functions = a_functions;
+}
+
+// enabled options of a tuned function, as flags
+string application::get_function_flags(const chromosome & a_options, size_t a_function) const
+{
+    string flags;
+    size_t first = get_global_option_count() + a_function * m_function_options.size();
+
+    for (size_t n = 0; n < m_function_options.size(); ++n)
+    {
+        if (a_options[first + n]->is_enabled())
+            flags += (flags.empty() ? "" : " ") + a_options[first + n]->get();
+    }
+
+    return flags;
+}
+
+// an option's text for reports, naming its function if it has one
+string application::get_option_label(size_t a_index, const string & a_text) const
+{
+    size_t global_options = get_global_option_count();
+
+    if (a_index < global_options)
+        return a_text;
+
+    return m_functions[(a_index - global_options) / m_function_options.size()] + ": " + a_text;
+}
+
+// is a position in source preceded on its line only by blanks?
+static bool at_line_start(const string & a_source, size_t a_pos)
+{
+    while ((a_pos > 0) && ((a_source[a_pos - 1] == ' ') || (a_source[a_pos - 1] == '\t')))
+        --a_pos;
+
+    return (a_pos == 0) || (a_source[a_pos - 1] == '\n');
+}
+
+// skip whitespace, comments and preprocessor lines in C source, returning
+//   the position of the next token
+static size_t skip_c_space(const string & a_source, size_t a_pos)
+{
+    while (a_pos < a_source.size())
+    {
+        if (isspace(static_cast<unsigned char>(a_source[a_pos])))
+            ++a_pos;
+        else if (a_source.compare(a_pos,2,"//") == 0)
+            a_pos = min(a_source.find('\n',a_pos),a_source.size());
+        else if (a_source.compare(a_pos,2,"/*") == 0)
+        {
+            size_t end = a_source.find("*/",a_pos + 2);
+            a_pos = (end == string::npos) ? a_source.size() : end + 2;
+        }
+        else if ((a_source[a_pos] == '#') && at_line_start(a_source,a_pos))
+        {
+            // a directive continues past escaped line ends
+            while ((a_pos < a_source.size()) && (a_source[a_pos] != '\n'))
+                a_pos += (a_source[a_pos] == '\\') ? 2 : 1;
+        }
+        else
+            break;
+    }
+
+    return min(a_pos,a_source.size());
+}
+
+// skip a C token: an identifier or number, a literal, or one character
+static size_t skip_c_token(const string & a_source, size_t a_pos)
+{
+    char c = a_source[a_pos];
+
+    if (isalnum(static_cast<unsigned char>(c)) || (c == '_'))
+    {
+        while ((a_pos < a_source.size()) && (isalnum(static_cast<unsigned char>(a_source[a_pos])) || (a_source[a_pos] == '_')))
+            ++a_pos;
+    }
+    else if ((c == '"') || (c == '\''))
+    {
+        ++a_pos;
+
+        while ((a_pos < a_source.size()) && (a_source[a_pos] != c))
+            a_pos += (a_source[a_pos] == '\\') ? 2 : 1;
+
+        ++a_pos;
+    }
+    else
+        ++a_pos;
+
+    return min(a_pos,a_source.size());
+}
+
+// skip a parenthesized or braced group, returning npos if it isn't closed
+static size_t skip_c_group(const string & a_source, size_t a_pos)
+{
+    char open  = a_source[a_pos];
+    char close = (open == '(') ? ')' : '}';
+    int  depth = 0;
+
+    while (a_pos < a_source.size())
+    {
+        if (a_source[a_pos] == open)
+            ++depth;
+        else if ((a_source[a_pos] == close) && (--depth == 0))
+            return a_pos + 1;
+
+        a_pos = skip_c_space(a_source,skip_c_token(a_source,a_pos));
+    }
+
+    return string::npos;
+}
+
+// find the definition of a function in C source, from the start of its
+//   declaration to its closing brace
+static bool find_c_function(const string & a_source, const string & a_name, size_t & a_begin, size_t & a_end)
+{
+    size_t pos   = skip_c_space(a_source,0);
+    size_t start = pos;
+    int    depth = 0;
+
+    while (pos < a_source.size())
+    {
+        size_t next = skip_c_token(a_source,pos);
+        char   c    = a_source[pos];
+
+        if ((depth == 0) && (next - pos == a_name.size()) && (a_source.compare(pos,next - pos,a_name) == 0))
+        {
+            // the name, then parameters and a body
+            size_t params = skip_c_space(a_source,next);
+
+            if ((params < a_source.size()) && (a_source[params] == '('))
+            {
+                size_t body = skip_c_group(a_source,params);
+
+                if (body != string::npos)
+                {
+                    body = skip_c_space(a_source,body);
+
+                    if ((body < a_source.size()) && (a_source[body] == '{'))
+                    {
+                        a_begin = start;
+                        a_end   = skip_c_group(a_source,body);
+                        return a_end != string::npos;
+                    }
+                }
+            }
+        }
+
+        pos = skip_c_space(a_source,next);
+
+        // a declaration at file scope ends with a semicolon or a brace
+        if (c == '{')
+            ++depth;
+        else if ((c == '}') && (depth > 0))
+            --depth;
+
+        if ((depth == 0) && ((c == ';') || (c == '}')))
+            start = pos;
+    }
+
+    return false;
+}
+
+// read a whole file; returns false if it can't be read
+static bool read_text_file(const string & a_file_name, string & a_text)
+{
+    ifstream file(a_file_name.c_str());
+
+    if (!file)
+        return false;
+
+    ostringstream text;
+    text << file.rdbuf();
+    a_text = text.str();
+    return true;
+}
+
+// line number of a position in source
+static size_t source_line(const string & a_source, size_t a_pos)
+{
+    return count(a_source.begin(),a_source.begin() + a_pos,'\n') + 1;
+}
+
+// does an input define a function?
+bool application::defines_function(const string & a_input_name, const string & a_function) const
+{
+    string source;
+    size_t begin;
+    size_t end;
+
+    return read_text_file(a_input_name,source) && find_c_function(source,a_function,begin,end);
+}
+
+// source of an input with each tuned function's options in pragmas
+string application::get_function_source(const string & a_input_name, const chromosome & a_options) const
+{
+    string source;
+
+    if (!read_text_file(a_input_name,source))
+        return string();
+
+    // the generated source is compiled elsewhere, so headers included by
+    //   quoted name are found through absolute paths
+    string dir("./");
+    size_t slash = a_input_name.rfind('/');
+
+    if (slash != string::npos)
+        dir = a_input_name.substr(0,slash + 1);
+
+    char * real_dir = realpath(dir.c_str(),NULL);
+
+    if (real_dir != NULL)
+    {
+        dir = string(real_dir) + "/";
+        free(real_dir);
+    }
+
+    size_t line = 0;
+
+    while (line < source.size())
+    {
+        size_t hash = source.find_first_not_of(" \t",line);
+
+        if ((hash != string::npos) && (source[hash] == '#'))
+        {
+            size_t keyword = source.find_first_not_of(" \t",hash + 1);
+
+            if ((keyword != string::npos) && (source.compare(keyword,7,"include") == 0))
+            {
+                size_t quote = source.find_first_not_of(" \t",keyword + 7);
+
+                if ((quote != string::npos) && (source[quote] == '"') && (source.compare(quote + 1,1,"/") != 0))
+                    source.insert(quote + 1,dir);
+            }
+        }
+
+        size_t end = source.find('\n',line);
+
+        if (end == string::npos)
+            break;
+
+        line = end + 1;
+    }
+
+    // place functions in the order they're defined
+    vector< pair<size_t, size_t> > places;
+    vector<size_t> ends(m_functions.size());
+
+    for (size_t f = 0; f < m_functions.size(); ++f)
+    {
+        size_t begin;
+
+        if (find_c_function(source,m_functions[f],begin,ends[f]) && !get_function_flags(a_options,f).empty())
+            places.push_back(make_pair(begin,f));
+    }
+
+    sort(places.begin(),places.end());
+
+    ostringstream result;
+    size_t copied = 0;
+
+    for (size_t n = 0; n < places.size(); ++n)
+    {
+        size_t begin = places[n].first;
+        size_t end   = ends[places[n].second];
+
+        istringstream flags(get_function_flags(a_options,places[n].second));
+        string flag;
+        string separator;
+
+        result << source.substr(copied,begin - copied)
+               << "\n#pragma GCC push_options\n#pragma GCC optimize (";
+
+        while (flags >> flag)
+        {
+            result << separator << "\"" << flag << "\"";
+            separator = ",";
+        }
+
+        result << ")\n#line " << source_line(source,begin) << " \"" << a_input_name << "\"\n"
+               << source.substr(begin,end - begin)
+               << "\n#pragma GCC pop_options\n#line " << source_line(source,end) << " \"" << a_input_name << "\"\n";
+
+        copied = end;
+    }
+
+    result << source.substr(copied);
+    return result.str();
+}
+
+// get a random set of options for this application
+chromosome application::get_random_options() const
+{
+    int n;
+    
+    // result
+    chromosome options;
+    
+    // push_back options
+    for (n = 0; n < m_options.size(); ++n)
+        options.push_back(m_options[n]->clone());
+    
+    for (n = 0; n < m_options.size(); ++n)
+	    options[n]->randomize();
+    
+    // done
+    return options;
+}
+
+// breed a new options set from two parents
+chromosome application::breed(const chromosome & a_parent1,
+                           const chromosome & a_parent2) const
+{
+    // This function assumes that the two lists are the same length, and
+    // contain the same list of options in the same order
+    if (a_parent1.size() != a_parent2.size())
+    {
+        char message[128];
+        snprintf(message,128,"incompatible option vectors in breeding (sizes %lu and %lu)",a_parent1.size(),a_parent2.size());
+        throw invalid_argument(message);
+    }
+    
+    // result
+    chromosome child;
+    
+    // randomly pick an option from one of the parents
+    for (int n = 0; n < a_parent1.size(); ++n)
+    {
+        if (g_random.get_real() < 0.5)
+            child.push_back(a_parent1[n]->clone());
+        else
+            child.push_back(a_parent2[n]->clone());
+    }
+    
+    // done
+    return child;
+}
+
+// mutate an option set
+void application::mutate(chromosome & a_options,
                             double a_mutation_chance) const
 {
     for (int n = 0; n < a_options.size(); ++n)
@@ -953,26 +1876,34 @@ application::~application()
 //----------------------------------------------------------
 // the organism undergoing evolution
 acovea_organism::acovea_organism()
-  : organism< chromosome >()
+  : organism< chromosome >(),
+    m_run_time(0.0),
+    m_code_size(0.0)
 {
     // nada
 }
 
 acovea_organism::acovea_organism(const application & a_target)
-  : organism< chromosome >(a_target.get_random_options())
+  : organism< chromosome >(a_target.get_random_options()),
+    m_run_time(0.0),
+    m_code_size(0.0)
 {
     // nada
 }
 
 acovea_organism::acovea_organism(const application & a_target,
                                  const chromosome & a_genes)
-  : organism< chromosome >(a_genes)
+  : organism< chromosome >(a_genes),
+    m_run_time(0.0),
+    m_code_size(0.0)
 {
     // nada
 }
 
 acovea_organism::acovea_organism(const acovea_organism & a_source)
-  : organism< chromosome >(a_source)
+  : organism< chromosome >(a_source),
+    m_run_time(a_source.m_run_time),
+    m_code_size(a_source.m_code_size)
 {
     // nada
 }
@@ -980,7 +1911,9 @@ acovea_organism::acovea_organism(const acovea_organism & a_source)
 acovea_organism::acovea_organism(const acovea_organism & a_parent1,
                                  const acovea_organism & a_parent2,
                                  const application & a_target)
-  : organism< chromosome >()
+  : organism< chromosome >(),
+    m_run_time(0.0),
+    m_code_size(0.0)
 {
     m_genes = a_target.breed(a_parent1.genes(),a_parent2.genes());
 }
@@ -993,58 +1926,271 @@ acovea_organism::~acovea_organism()
 acovea_organism & acovea_organism::operator = (const acovea_organism & a_source)
 {
     organism< chromosome >::operator = (a_source);
+    m_run_time  = a_source.m_run_time;
+    m_code_size = a_source.m_code_size;
     return *this;
 }
 
 //----------------------------------------------------------
-// mutation operator
-acovea_mutator::acovea_mutator(double a_mutation_rate, const application & a_target)
-  : m_mutation_rate(a_mutation_rate),
-    m_target(a_target)
-{
-    // adjust mutation rate if necessary
-    if (m_mutation_rate >= 0.95)
-        m_mutation_rate = 0.95;
-    else if (m_mutation_rate < 0.0)
-        m_mutation_rate = 0.0;
-}
+// surrogate fitness model
 
-// copy constructor
-acovea_mutator::acovea_mutator(const acovea_mutator & a_source)
-  : m_mutation_rate(a_source.m_mutation_rate),
-    m_target(a_source.m_target)
+// creation constructor
+surrogate_model::surrogate_model(const application & a_target)
+  : m_features(1),
+    m_weights(),
+    m_covariance(),
+    m_samples(0),
+    m_gen_error(0.0),
+    m_gen_count(0)
 {
-    // nada
-}
+    // one indicator per choice, plus the value of tuning options
+    chromosome options = a_target.get_options();
 
-// destructor
-acovea_mutator::~acovea_mutator()
-{
-    // nada
+    for (int n = 0; n < options.size(); ++n)
+    {
+        m_features += options[n]->get_choices().size();
+
+        if (options[n]->has_settings())
+            ++m_features;
+    }
+
+    m_weights.resize(m_features,0.0);
+
+    // weak prior: large initial covariance along the diagonal
+    static const double PRIOR_VARIANCE = 1000.0;
+
+    m_covariance.resize(m_features * m_features,0.0);
+
+    for (size_t n = 0; n < m_features; ++n)
+        m_covariance[n * m_features + n] = PRIOR_VARIANCE;
 }
 
-// assignment -- note, this can not change the target!
-acovea_mutator & acovea_mutator::operator = (const acovea_mutator & a_source)
+// convert options into a feature vector
+vector<double> surrogate_model::encode(const chromosome & a_genes) const
 {
-    m_mutation_rate = a_source.m_mutation_rate;
-    return *this;
+    vector<double> features(m_features,0.0);
+
+    // bias
+    features[0] = 1.0;
+
+    size_t f = 1;
+
+    for (int n = 0; (n < a_genes.size()) && (f < m_features); ++n)
+    {
+        size_t choices = a_genes[n]->get_choices().size();
+
+        if (a_genes[n]->is_enabled())
+            features[f + a_genes[n]->get_setting()] = 1.0;
+
+        f += choices;
+
+        // tuning values, in steps away from the default
+        if (a_genes[n]->has_settings())
+        {
+            const tuning_option * tuning = dynamic_cast<const tuning_option *>(a_genes[n]);
+
+            if ((tuning != NULL) && tuning->is_enabled())
+                features[f] = static_cast<double>(tuning->get_value() - tuning->get_default()) / 10.0;
+
+            ++f;
+        }
+    }
+
+    return features;
 }
 
-// mutation
-void acovea_mutator::mutate(vector< acovea_organism > & a_population)
+// predict the fitness of a set of options
+double surrogate_model::predict(const chromosome & a_genes) const
 {
-    for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
-        m_target.mutate(org->genes(),m_mutation_rate);
+    vector<double> x = encode(a_genes);
+    double result = 0.0;
+
+    for (size_t i = 0; i < m_features; ++i)
+        result += m_weights[i] * x[i];
+
+    return result;
 }
 
-//----------------------------------------------------------
-// reproduction operator
-// creation constructor
-acovea_reproducer::acovea_reproducer(double a_crossover_rate, const application & a_target)
-  : m_crossover_rate(a_crossover_rate),
-    m_target(a_target)
+// add a measured organism to the model (recursive least squares)
+void surrogate_model::train(const chromosome & a_genes, double a_fitness)
 {
-    // adjust crossover rate if necessary
+    // failures carry no information about speed
+    if (a_fitness == BOGUS_RUN_TIME)
+        return;
+
+    // track how well the model predicted this organism
+    if (is_trained() && (a_fitness != 0.0))
+    {
+        m_gen_error += fabs(predict(a_genes) - a_fitness) / fabs(a_fitness);
+        ++m_gen_count;
+    }
+
+    vector<double> x = encode(a_genes);
+
+    // Px and x'Px
+    vector<double> px(m_features,0.0);
+    double xpx = 0.0;
+
+    for (size_t i = 0; i < m_features; ++i)
+    {
+        for (size_t j = 0; j < m_features; ++j)
+            px[i] += m_covariance[i * m_features + j] * x[j];
+
+        xpx += x[i] * px[i];
+    }
+
+    // gain and prediction error
+    double error = a_fitness;
+
+    for (size_t i = 0; i < m_features; ++i)
+        error -= m_weights[i] * x[i];
+
+    double denominator = 1.0 + xpx;
+
+    for (size_t i = 0; i < m_features; ++i)
+        m_weights[i] += px[i] * error / denominator;
+
+    // P = P - (Px)(Px)' / (1 + x'Px), since P is symmetric
+    for (size_t i = 0; i < m_features; ++i)
+    {
+        for (size_t j = 0; j < m_features; ++j)
+            m_covariance[i * m_features + j] -= px[i] * px[j] / denominator;
+    }
+
+    ++m_samples;
+}
+
+// prediction error for the current generation
+string surrogate_model::get_stats_text() const
+{
+    ostringstream result;
+
+    result << "surrogate model: " << m_samples << " organisms trained";
+
+    if (m_gen_count > 0)
+        result << ", mean prediction error " << fixed << setprecision(1)
+               << (100.0 * m_gen_error / m_gen_count) << "% over " << m_gen_count << " tests";
+    else if (!is_trained())
+        result << ", not yet screening (" << m_features << " needed)";
+
+    result << "\n";
+    return result.str();
+}
+
+// begin measuring error for a new generation
+void surrogate_model::reset_generation_stats()
+{
+    m_gen_error = 0.0;
+    m_gen_count = 0;
+}
+
+// write the model to a checkpoint
+void surrogate_model::save(FILE * a_file) const
+{
+    write_value<uint64_t>(a_file,m_features);
+    write_value<uint64_t>(a_file,m_samples);
+
+    if (fwrite(&m_weights[0],sizeof(double),m_features,a_file) != m_features)
+        throw runtime_error("unable to write checkpoint");
+
+    if (fwrite(&m_covariance[0],sizeof(double),m_features * m_features,a_file) != m_features * m_features)
+        throw runtime_error("unable to write checkpoint");
+}
+
+// read the model from a checkpoint
+void surrogate_model::load(FILE * a_file)
+{
+    if (read_value<uint64_t>(a_file) != m_features)
+        throw runtime_error("checkpoint surrogate model does not match configuration");
+
+    m_samples = read_value<uint64_t>(a_file);
+
+    if (fread(&m_weights[0],sizeof(double),m_features,a_file) != m_features)
+        throw runtime_error("checkpoint is truncated");
+
+    if (fread(&m_covariance[0],sizeof(double),m_features * m_features,a_file) != m_features * m_features)
+        throw runtime_error("checkpoint is truncated");
+}
+
+//----------------------------------------------------------
+// mutation operator
+acovea_mutator::acovea_mutator(double a_mutation_rate, const application & a_target)
+  : m_mutation_rate(a_mutation_rate),
+    m_in_breeding(false),
+    m_target(a_target)
+{
+    // adjust mutation rate if necessary
+    if (m_mutation_rate >= 0.95)
+        m_mutation_rate = 0.95;
+    else if (m_mutation_rate < 0.0)
+        m_mutation_rate = 0.0;
+}
+
+// copy constructor
+acovea_mutator::acovea_mutator(const acovea_mutator & a_source)
+  : m_mutation_rate(a_source.m_mutation_rate),
+    m_in_breeding(a_source.m_in_breeding),
+    m_target(a_source.m_target)
+{
+    // nada
+}
+
+// destructor
+acovea_mutator::~acovea_mutator()
+{
+    // nada
+}
+
+// assignment -- note, this can not change the target!
+acovea_mutator & acovea_mutator::operator = (const acovea_mutator & a_source)
+{
+    m_mutation_rate = a_source.m_mutation_rate;
+    m_in_breeding   = a_source.m_in_breeding;
+    return *this;
+}
+
+// change the mutation rate
+void acovea_mutator::set_mutation_rate(double a_mutation_rate)
+{
+    if (a_mutation_rate >= 0.95)
+        m_mutation_rate = 0.95;
+    else if (a_mutation_rate < 0.0)
+        m_mutation_rate = 0.0;
+    else
+        m_mutation_rate = a_mutation_rate;
+}
+
+// mutation
+void acovea_mutator::mutate(vector< acovea_organism > & a_population)
+{
+    if (m_in_breeding)
+        return;
+
+    for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
+        mutate_child(org->genes());
+}
+
+// mutation of a single child; when it happens during breeding, its time
+//   also counts as breeding
+void acovea_mutator::mutate_child(chromosome & a_genes)
+{
+    ACOVEA_TIME_PHASE(mutate_timer,PHASE_MUTATE);
+    m_target.mutate(a_genes,m_mutation_rate);
+}
+
+//----------------------------------------------------------
+// reproduction operator
+// creation constructor
+acovea_reproducer::acovea_reproducer(double a_crossover_rate, const application & a_target)
+  : m_crossover_rate(a_crossover_rate),
+    m_surrogate(NULL),
+    m_screen_factor(1),
+    m_exploration(0.0),
+    m_filter(NULL),
+    m_mutator(NULL),
+    m_target(a_target)
+{
+    // adjust crossover rate if necessary
     if (m_crossover_rate > 1.0)
         m_crossover_rate = 1.0;
     else if (m_crossover_rate < 0.0)
@@ -1054,6 +2200,11 @@ acovea_reproducer::acovea_reproducer(double a_crossover_rate, const application
 // copy constructor
 acovea_reproducer::acovea_reproducer(const acovea_reproducer & a_source)
   : m_crossover_rate(a_source.m_crossover_rate),
+    m_surrogate(a_source.m_surrogate),
+    m_screen_factor(a_source.m_screen_factor),
+    m_exploration(a_source.m_exploration),
+    m_filter(a_source.m_filter),
+    m_mutator(a_source.m_mutator),
     m_target(a_source.m_target)
 {
     // nada
@@ -1069,16 +2220,41 @@ acovea_reproducer::~acovea_reproducer()
 acovea_reproducer & acovea_reproducer::operator = (const acovea_reproducer & a_source)
 {
     m_crossover_rate = a_source.m_crossover_rate;
+    m_surrogate      = a_source.m_surrogate;
+    m_screen_factor  = a_source.m_screen_factor;
+    m_exploration    = a_source.m_exploration;
+    m_filter         = a_source.m_filter;
+    m_mutator        = a_source.m_mutator;
     return *this;
 }
 
+// change the crossover rate
+void acovea_reproducer::set_crossover_rate(double a_crossover_rate)
+{
+    if (a_crossover_rate > 1.0)
+        m_crossover_rate = 1.0;
+    else if (a_crossover_rate < 0.0)
+        m_crossover_rate = 0.0;
+    else
+        m_crossover_rate = a_crossover_rate;
+}
+
 // interrogator
 vector<acovea_organism> acovea_reproducer::breed(const vector< acovea_organism > & a_population,
                                                  size_t a_limit)
 {
+    ACOVEA_TIME_PHASE(breed_timer,PHASE_BREED);
+
     // result
     vector< acovea_organism > children;
 
+    // when screening, breed extra candidates and keep the most promising
+    bool screening = (m_surrogate != NULL) && m_surrogate->is_trained() && (m_screen_factor > 1);
+    size_t wanted  = a_limit;
+
+    if (screening)
+        a_limit *= m_screen_factor;
+
     if (a_limit > 0U)
     {
         // construct a fitness wheel
@@ -1089,30 +2265,56 @@ vector<acovea_organism> acovea_reproducer::breed(const vector< acovea_organism >
 
         roulette_wheel fitness_wheel(wheel_weights);
 
+        // children must differ from the population they're bred from
+        if (m_filter != NULL)
+            m_filter->set_population(a_population);
+
         // create children
         while (a_limit > 0)
         {
-            // clone an existing organism as a child
-            size_t first_index = fitness_wheel.get_index();
-            acovea_organism * child;
+            acovea_organism * child = NULL;
 
-            // do we crossover?
-            if (g_random.get_real() <= m_crossover_rate)
+            // a child repeating a known genome is bred again, a limited number of times
+            for (size_t attempt = 0; child == NULL; ++attempt)
             {
-                // select a second parent
-                size_t second_index = first_index;
+                // clone an existing organism as a child
+                size_t first_index = fitness_wheel.get_index();
+
+                // do we crossover?
+                if (g_random.get_real() <= m_crossover_rate)
+                {
+                    // select a second parent
+                    size_t second_index = first_index;
+
+                    while (second_index == first_index)
+                        second_index = fitness_wheel.get_index();
+
+                    // reproduce
+                    child = new acovea_organism(m_target,
+                                                m_target.breed(a_population[first_index].genes(),
+                                                               a_population[second_index].genes()));
+                }
+                else
+                    // no crossover; just copy first organism chosen
+                    child = new acovea_organism(a_population[first_index]);
 
-                while (second_index == first_index)
-                    second_index = fitness_wheel.get_index();
+                // mutate before screening and filtering, so that the
+                //   genome judged is the one tested
+                if (m_mutator != NULL)
+                    m_mutator->mutate_child(child->genes());
 
-                // reproduce
-                child = new acovea_organism(m_target,
-                                            m_target.breed(a_population[first_index].genes(),
-                                                           a_population[second_index].genes()));
+                if ((m_filter != NULL) && (attempt < m_filter->retries()) && !m_filter->is_new(child->genes()))
+                {
+                    m_filter->note_redraw();
+                    delete child;
+                    child = NULL;
+                }
             }
-            else
-                // no crossover; just copy first organism chosen
-                child = new acovea_organism(a_population[first_index]);
+
+            // a remaining duplicate is mutated instead; when screening,
+            //   only the candidates chosen are recorded
+            if ((m_filter != NULL) && !screening)
+                m_filter->accept(child->genes());
 
             // add child to new population
             children.push_back(*child);
@@ -1123,237 +2325,4249 @@ vector<acovea_organism> acovea_reproducer::breed(const vector< acovea_organism >
         }
     }
 
+    if (screening)
+    {
+        // rank candidates by predicted fitness (lower is better)
+        vector< pair<double, size_t> > ranking;
+
+        for (size_t n = 0; n < children.size(); ++n)
+            ranking.push_back(make_pair(m_surrogate->predict(children[n].genes()),n));
+
+        sort(ranking.begin(),ranking.end());
+
+        // the best predictions, plus a few random picks to keep the model honest
+        size_t explore = size_t(wanted * m_exploration + 0.5);
+
+        if (explore > wanted)
+            explore = wanted;
+
+        vector< acovea_organism > chosen;
+
+        for (size_t n = 0; n < wanted - explore; ++n)
+            chosen.push_back(children[ranking[n].second]);
+
+        for (size_t n = wanted - explore; n < wanted; ++n)
+        {
+            // pick from the candidates not yet chosen
+            size_t pick = n + g_random.get_index(ranking.size() - n);
+            swap(ranking[n],ranking[pick]);
+            chosen.push_back(children[ranking[n].second]);
+        }
+
+        if (m_filter != NULL)
+        {
+            for (size_t n = 0; n < chosen.size(); ++n)
+                m_filter->accept(chosen[n].genes());
+        }
+
+        children = chosen;
+    }
+
     // outa here!
     return children;
 }
 
 //----------------------------------------------------------
-// fitness landscape
+// diversity controller
 
-acovea_landscape::acovea_landscape(string a_bench_name,
-                                   optimization_mode a_mode,
-                                   const application & a_target,
-                                   acovea_listener & a_listener)
-    : landscape<acovea_organism>(a_listener),
-      m_input_name(a_bench_name),
-      m_target(a_target),
-      m_mode(a_mode)
+// factors applied to the rates for each generation outside the band
+static const double MUTATION_STEP  = 1.5;
+static const double CROSSOVER_STEP = 0.9;
+
+// creation constructor
+diversity_controller::diversity_controller(acovea_mutator &    a_mutator,
+                                           acovea_reproducer & a_reproducer,
+                                           bool                a_adaptive,
+                                           double              a_low,
+                                           double              a_high)
+  : m_mutator(a_mutator),
+    m_reproducer(a_reproducer),
+    m_adaptive(a_adaptive),
+    m_low(a_low),
+    m_high(a_high),
+    m_base_mutation(a_mutator.mutation_rate()),
+    m_base_crossover(a_reproducer.crossover_rate())
 {
-    // nada
+    if (m_adaptive && ((m_low < 0.0) || (m_high > 1.0) || (m_low >= m_high)))
+        throw runtime_error("diversity band must satisfy 0 <= low < high <= 1");
 }
 
-acovea_landscape::acovea_landscape(const acovea_landscape & a_source)
-    : landscape<acovea_organism>(a_source),
-      m_input_name(a_source.m_input_name),
-      m_target(a_source.m_target),
-      m_mode(a_source.m_mode)
+// state of an option, for comparing organisms: 0 when disabled, otherwise
+//   one more than its setting
+static int option_state(const option * a_option)
 {
-    // nada
+    return a_option->is_enabled() ? (a_option->get_setting() + 1) : 0;
 }
 
-acovea_landscape & acovea_landscape::operator = (const acovea_landscape & a_source)
+// measure the diversity of a set of populations
+diversity diversity_controller::measure(const vector< vector<acovea_organism> > & a_populations)
 {
-    landscape<acovea_organism>::operator = (a_source);
-    m_input_name = a_source.m_input_name;
-    m_mode = a_source.m_mode;
-    // can't duplicate m_target since it's a reference
-    return *this;
+    diversity result = { 0.0, 0.0 };
+    size_t counted = 0;
+
+    for (size_t p = 0; p < a_populations.size(); ++p)
+    {
+        const vector<acovea_organism> & pop = a_populations[p];
+
+        if (pop.size() < 2)
+            continue;
+
+        size_t genes = pop[0].genes().size();
+
+        if (genes == 0)
+            continue;
+
+        // pack enabled flags into words, so most differences are counted a
+        //   word at a time; options with settings are compared separately
+        size_t words = (genes + 63) / 64;
+        vector<uint64_t> packed(pop.size() * words,0);
+        vector<size_t>   detailed;
+
+        for (size_t g = 0; g < genes; ++g)
+        {
+            if ((pop[0].genes()[g]->get_choices().size() > 1)
+            ||  (dynamic_cast<const tuning_option *>(pop[0].genes()[g]) != NULL))
+                detailed.push_back(g);
+        }
+
+        for (size_t n = 0; n < pop.size(); ++n)
+        {
+            for (size_t g = 0; g < genes; ++g)
+            {
+                if (pop[n].genes()[g]->is_enabled())
+                    packed[n * words + g / 64] |= (uint64_t(1) << (g % 64));
+            }
+        }
+
+        // mean distance over all pairs
+        double distance = 0.0;
+
+        for (size_t a = 0; a < pop.size(); ++a)
+        {
+            for (size_t b = a + 1; b < pop.size(); ++b)
+            {
+                size_t differ = 0;
+
+                for (size_t w = 0; w < words; ++w)
+                    differ += __builtin_popcountll(packed[a * words + w] ^ packed[b * words + w]);
+
+                for (size_t d = 0; d < detailed.size(); ++d)
+                {
+                    const option * left  = pop[a].genes()[detailed[d]];
+                    const option * right = pop[b].genes()[detailed[d]];
+
+                    if (!left->is_enabled() || !right->is_enabled())
+                        continue;
+
+                    const tuning_option * left_tuning  = dynamic_cast<const tuning_option *>(left);
+                    const tuning_option * right_tuning = dynamic_cast<const tuning_option *>(right);
+
+                    if ((left->get_setting() != right->get_setting())
+                    ||  ((left_tuning != NULL) && (right_tuning != NULL) && (left_tuning->get_value() != right_tuning->get_value())))
+                        ++differ;
+                }
+
+                distance += static_cast<double>(differ) / static_cast<double>(genes);
+            }
+        }
+
+        distance /= static_cast<double>(pop.size() * (pop.size() - 1) / 2);
+
+        // mean entropy of each option's states, relative to the most possible
+        double entropy = 0.0;
+
+        for (size_t g = 0; g < genes; ++g)
+        {
+            size_t states = pop[0].genes()[g]->get_choices().size() + 1;
+            vector<size_t> counts(states,0);
+
+            for (size_t n = 0; n < pop.size(); ++n)
+            {
+                size_t state = static_cast<size_t>(option_state(pop[n].genes()[g]));
+
+                if (state < states)
+                    ++counts[state];
+            }
+
+            double h = 0.0;
+
+            for (size_t k = 0; k < states; ++k)
+            {
+                if (counts[k] > 0)
+                {
+                    double f = static_cast<double>(counts[k]) / static_cast<double>(pop.size());
+                    h -= f * log(f);
+                }
+            }
+
+            entropy += h / log(static_cast<double>(min(states,pop.size())));
+        }
+
+        result.m_entropy  += entropy / static_cast<double>(genes);
+        result.m_distance += distance;
+        ++counted;
+    }
+
+    if (counted > 0)
+    {
+        result.m_entropy  /= static_cast<double>(counted);
+        result.m_distance /= static_cast<double>(counted);
+    }
+
+    return result;
+}
+
+// measure diversity after a generation, adjusting rates if requested
+diversity diversity_controller::update(const vector< vector<acovea_organism> > & a_populations, bool a_adjust)
+{
+    diversity result = measure(a_populations);
+
+    if (m_adaptive && a_adjust)
+    {
+        // rates stay within a factor of the command line's
+        double mutation  = m_mutator.mutation_rate();
+        double crossover = m_reproducer.crossover_rate();
+
+        if (result.m_distance < m_low)
+        {
+            mutation  = min(mutation * MUTATION_STEP,m_base_mutation * 8.0);
+            crossover = max(crossover * CROSSOVER_STEP,m_base_crossover * 0.5);
+        }
+        else if (result.m_distance > m_high)
+        {
+            mutation  = max(mutation / MUTATION_STEP,m_base_mutation / 8.0);
+            crossover = min(crossover / CROSSOVER_STEP,m_base_crossover);
+        }
+
+        m_mutator.set_mutation_rate(mutation);
+        m_reproducer.set_crossover_rate(crossover);
+    }
+
+    return result;
+}
+
+// description for configuration reports
+string diversity_controller::get_description() const
+{
+    if (!m_adaptive)
+        return string("disabled");
+
+    ostringstream text;
+    text << "mean distance held between " << m_low << " and " << m_high;
+    return text.str();
+}
+
+// save the adjusted rates
+void diversity_controller::save(FILE * a_file) const
+{
+    write_value<double>(a_file,m_mutator.mutation_rate());
+    write_value<double>(a_file,m_reproducer.crossover_rate());
+}
+
+// restore the adjusted rates
+void diversity_controller::load(FILE * a_file)
+{
+    double mutation  = read_value<double>(a_file);
+    double crossover = read_value<double>(a_file);
+
+    if (m_adaptive)
+    {
+        m_mutator.set_mutation_rate(mutation);
+        m_reproducer.set_crossover_rate(crossover);
+    }
+}
+
+//----------------------------------------------------------
+// binary fingerprint cache
+
+// 64-bit FNV-1a hash parameters
+static const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+static const uint64_t FNV_PRIME  = 1099511628211ULL;
+
+static uint64_t fnv1a(uint64_t a_hash, const unsigned char * a_data, size_t a_length)
+{
+    for (size_t n = 0; n < a_length; ++n)
+    {
+        a_hash ^= a_data[n];
+        a_hash *= FNV_PRIME;
+    }
+
+    return a_hash;
+}
+
+// hash the loaded, non-note sections of an ELF image; returns false if the
+//   image is not a well-formed ELF file of the given class
+template <typename Ehdr, typename Shdr>
+static bool hash_elf_sections(const vector<unsigned char> & a_image, uint64_t & a_hash)
+{
+    if (a_image.size() < sizeof(Ehdr))
+        return false;
+
+    const Ehdr * header = reinterpret_cast<const Ehdr *>(&a_image[0]);
+
+    if ((header->e_shoff == 0) || (header->e_shentsize != sizeof(Shdr))
+    ||  (header->e_shoff + header->e_shnum * sizeof(Shdr) > a_image.size()))
+        return false;
+
+    const Shdr * sections = reinterpret_cast<const Shdr *>(&a_image[header->e_shoff]);
+
+    // the entry point is part of the program's behavior
+    a_hash = fnv1a(a_hash,reinterpret_cast<const unsigned char *>(&header->e_entry),sizeof(header->e_entry));
+
+    for (size_t n = 0; n < header->e_shnum; ++n)
+    {
+        // skip debug info, symbol tables, comments, build IDs and other notes
+        if (((sections[n].sh_flags & SHF_ALLOC) == 0) || (sections[n].sh_type == SHT_NOTE))
+            continue;
+
+        // uninitialized data contributes only its size
+        if (sections[n].sh_type == SHT_NOBITS)
+        {
+            a_hash = fnv1a(a_hash,reinterpret_cast<const unsigned char *>(&sections[n].sh_size),sizeof(sections[n].sh_size));
+            continue;
+        }
+
+        if (sections[n].sh_offset + sections[n].sh_size > a_image.size())
+            return false;
+
+        a_hash = fnv1a(a_hash,&a_image[sections[n].sh_offset],sections[n].sh_size);
+    }
+
+    return true;
+}
+
+// creation constructor
+fitness_cache::fitness_cache(bool a_code_only, size_t a_refine_limit)
+  : m_entries(),
+    m_code_only(a_code_only),
+    m_refine_limit(a_refine_limit),
+    m_hits(0),
+    m_misses(0),
+    m_gen_hits(0),
+    m_gen_misses(0),
+    m_saved(0.0)
+{
+    // always take at least one sample
+    if (m_refine_limit < 1)
+        m_refine_limit = 1;
+}
+
+// compute the fingerprint of a compiled program
+uint64_t fitness_cache::fingerprint(const string & a_file_name) const
+{
+    vector<unsigned char> image;
+
+    // read the entire program
+    FILE * file = fopen(a_file_name.c_str(),"rb");
+
+    if (file == NULL)
+        return 0;
+
+    unsigned char buffer[65536];
+    size_t nread;
+
+    while ((nread = fread(buffer,1,sizeof(buffer),file)) > 0)
+        image.insert(image.end(),buffer,buffer + nread);
+
+    fclose(file);
+
+    if (image.empty())
+        return 0;
+
+    uint64_t hash = FNV_OFFSET;
+
+    // try to fingerprint only the code, for ELF programs
+    if (m_code_only && (image.size() > EI_CLASS) && (0 == memcmp(&image[0],ELFMAG,SELFMAG)))
+    {
+        bool hashed;
+
+        if (image[EI_CLASS] == ELFCLASS64)
+            hashed = hash_elf_sections<Elf64_Ehdr,Elf64_Shdr>(image,hash);
+        else
+            hashed = hash_elf_sections<Elf32_Ehdr,Elf32_Shdr>(image,hash);
+
+        if (hashed)
+            return hash;
+
+        hash = FNV_OFFSET;
+    }
+
+    // anything else is hashed in its entirety
+    return fnv1a(hash,&image[0],image.size());
+}
+
+// retrieve the mean fitness of a binary, if it has enough samples
+bool fitness_cache::lookup(uint64_t a_key, double & a_fitness)
+{
+    map<uint64_t, cache_entry>::const_iterator entry = m_entries.find(a_key);
+
+    // a binary that failed once isn't refined further
+    if ((entry != m_entries.end()) && ((entry->second.m_total == BOGUS_RUN_TIME) || (entry->second.m_samples >= m_refine_limit)))
+    {
+        if (entry->second.m_total == BOGUS_RUN_TIME)
+            a_fitness = BOGUS_RUN_TIME;
+        else
+            a_fitness = entry->second.m_total / static_cast<double>(entry->second.m_samples);
+
+        ++m_hits;
+        ++m_gen_hits;
+
+        if (a_fitness != BOGUS_RUN_TIME)
+            m_saved += a_fitness;
+
+        return true;
+    }
+
+    ++m_misses;
+    ++m_gen_misses;
+    return false;
+}
+
+// add a measurement for a binary; a failure is never averaged with
+//   run times, but marks the binary as failed
+void fitness_cache::record(uint64_t a_key, double a_fitness)
+{
+    map<uint64_t, cache_entry>::iterator entry = m_entries.find(a_key);
+
+    if (entry == m_entries.end())
+    {
+        cache_entry new_entry = { a_fitness, 1 };
+        m_entries[a_key] = new_entry;
+    }
+    else
+    {
+        if ((a_fitness == BOGUS_RUN_TIME) || (entry->second.m_total == BOGUS_RUN_TIME))
+            entry->second.m_total = BOGUS_RUN_TIME;
+        else
+            entry->second.m_total += a_fitness;
+
+        ++entry->second.m_samples;
+    }
+}
+
+// text describing the cache for configuration reports
+string fitness_cache::get_description() const
+{
+    ostringstream result;
+    result << (m_code_only ? "code sections" : "whole binary")
+           << ", " << m_refine_limit << " sample(s) per binary";
+    return result.str();
+}
+
+// hit rate for the current generation and the whole run
+string fitness_cache::get_stats_text() const
+{
+    ostringstream result;
+
+    size_t gen_total = m_gen_hits + m_gen_misses;
+    size_t total     = m_hits + m_misses;
+
+    result << "fitness cache: " << m_gen_hits << " of " << gen_total << " tests reused";
+
+    if (gen_total > 0)
+        result << " (" << fixed << setprecision(1) << (100.0 * m_gen_hits / gen_total) << "%)";
+
+    result << "; run total " << m_hits << " of " << total;
+
+    if (total > 0)
+        result << " (" << fixed << setprecision(1) << (100.0 * m_hits / total) << "%)";
+
+    result << ", " << m_entries.size() << " distinct binaries, "
+           << setprecision(2) << m_saved << " benchmark time saved\n";
+
+    return result.str();
+}
+
+// begin counting a new generation
+void fitness_cache::reset_generation_stats()
+{
+    m_gen_hits   = 0;
+    m_gen_misses = 0;
+}
+
+// write the cache contents to a checkpoint
+void fitness_cache::save(FILE * a_file) const
+{
+    write_value<uint64_t>(a_file,m_entries.size());
+
+    for (map<uint64_t, cache_entry>::const_iterator entry = m_entries.begin(); entry != m_entries.end(); ++entry)
+    {
+        write_value<uint64_t>(a_file,entry->first);
+        write_value<double>(a_file,entry->second.m_total);
+        write_value<uint64_t>(a_file,entry->second.m_samples);
+    }
+
+    write_value<uint64_t>(a_file,m_hits);
+    write_value<uint64_t>(a_file,m_misses);
+    write_value<double>(a_file,m_saved);
+}
+
+// read the cache contents from a checkpoint
+void fitness_cache::load(FILE * a_file)
+{
+    m_entries.clear();
+
+    uint64_t count = read_value<uint64_t>(a_file);
+
+    for (uint64_t n = 0; n < count; ++n)
+    {
+        uint64_t key = read_value<uint64_t>(a_file);
+        cache_entry entry;
+        entry.m_total   = read_value<double>(a_file);
+        entry.m_samples = read_value<uint64_t>(a_file);
+        m_entries[key]  = entry;
+    }
+
+    m_hits   = read_value<uint64_t>(a_file);
+    m_misses = read_value<uint64_t>(a_file);
+    m_saved  = read_value<double>(a_file);
+}
+
+//----------------------------------------------------------
+// offspring filter
+
+// creation constructor
+offspring_filter::offspring_filter(bool a_use_history, size_t a_retries)
+  : m_use_history(a_use_history),
+    m_retries(a_retries),
+    m_current(),
+    m_history(),
+    m_redrawn(0),
+    m_mutated(0),
+    m_kept(0)
+{
+    // nada
+}
+
+// hash of a genome, ignoring the settings of disabled options
+uint64_t offspring_filter::canonical_hash(const chromosome & a_genes)
+{
+    uint64_t hash = FNV_OFFSET;
+
+    for (int n = 0; n < a_genes.size(); ++n)
+    {
+        unsigned char enabled = a_genes[n]->is_enabled() ? 1 : 0;
+        hash = fnv1a(hash,&enabled,sizeof(enabled));
+
+        if (enabled)
+        {
+            const tuning_option * tuning = dynamic_cast<const tuning_option *>(a_genes[n]);
+
+            int32_t setting = a_genes[n]->get_setting();
+            int32_t value   = (tuning != NULL) ? tuning->get_value() : 0;
+
+            hash = fnv1a(hash,reinterpret_cast<const unsigned char *>(&setting),sizeof(setting));
+            hash = fnv1a(hash,reinterpret_cast<const unsigned char *>(&value),sizeof(value));
+        }
+    }
+
+    return hash;
+}
+
+// the population children are bred from
+void offspring_filter::set_population(const vector<acovea_organism> & a_population)
+{
+    m_current.clear();
+
+    for (vector<acovea_organism>::const_iterator org = a_population.begin(); org != a_population.end(); ++org)
+    {
+        uint64_t hash = canonical_hash(org->genes());
+        m_current.insert(hash);
+
+        if (m_use_history)
+            m_history.insert(hash);
+    }
+}
+
+// is a genome unknown to the filter?
+bool offspring_filter::is_new(const chromosome & a_genes) const
+{
+    uint64_t hash = canonical_hash(a_genes);
+
+    return (m_current.find(hash) == m_current.end())
+        && (!m_use_history || (m_history.find(hash) == m_history.end()));
+}
+
+// add a child to the population, mutating it first if it is a duplicate
+void offspring_filter::accept(chromosome & a_genes)
+{
+    if (!is_new(a_genes) && (a_genes.size() > 0))
+    {
+        for (size_t n = 0; (n < m_retries) && !is_new(a_genes); ++n)
+            a_genes[g_random.get_index(a_genes.size())]->mutate();
+
+        if (is_new(a_genes))
+            ++m_mutated;
+        else
+            ++m_kept;
+    }
+
+    m_current.insert(canonical_hash(a_genes));
+}
+
+// statistics for the last generation and the whole run
+string offspring_filter::get_stats_text() const
+{
+    ostringstream result;
+
+    result << "duplicate children: " << m_redrawn << " bred again, "
+           << m_mutated << " mutated, " << m_kept << " kept";
+
+    if (m_use_history)
+        result << "; " << m_history.size() << " genomes tested";
+
+    result << "\n";
+
+    return result.str();
+}
+
+// begin counting a new generation
+void offspring_filter::reset_generation_stats()
+{
+    m_redrawn = 0;
+    m_mutated = 0;
+    m_kept    = 0;
+}
+
+// description for configuration reports
+string offspring_filter::get_description() const
+{
+    ostringstream result;
+    result << (m_use_history ? "unique in run" : "unique in population")
+           << ", " << m_retries << " retries";
+    return result.str();
+}
+
+// write the history to a checkpoint
+void offspring_filter::save(FILE * a_file) const
+{
+    write_value<uint64_t>(a_file,m_history.size());
+
+    for (set<uint64_t>::const_iterator hash = m_history.begin(); hash != m_history.end(); ++hash)
+        write_value<uint64_t>(a_file,*hash);
+}
+
+// read the history from a checkpoint
+void offspring_filter::load(FILE * a_file)
+{
+    m_history.clear();
+
+    uint64_t count = read_value<uint64_t>(a_file);
+
+    for (uint64_t n = 0; n < count; ++n)
+        m_history.insert(read_value<uint64_t>(a_file));
+}
+
+//----------------------------------------------------------
+// multi-fidelity schedule
+
+// creation constructor
+fidelity_schedule::fidelity_schedule(double a_min_scale, double a_promote)
+  : m_scales(),
+    m_promote(a_promote),
+    m_gen_tests()
+{
+    size_t steps = 0;
+
+    // one rung for every time the promoted fraction fits between the
+    //   smallest scale and full scale, and at least one below full scale
+    if ((a_min_scale > 0.0) && (a_min_scale < 1.0) && (a_promote > 0.0) && (a_promote < 1.0))
+        steps = max(static_cast<size_t>(1),static_cast<size_t>(log(a_min_scale) / log(a_promote) + 1e-9));
+
+    for (size_t n = 0; n < steps; ++n)
+        m_scales.push_back(pow(a_min_scale,1.0 - static_cast<double>(n) / steps));
+
+    m_scales.push_back(1.0);
+    m_gen_tests.assign(m_scales.size(),0);
+}
+
+// number of a rung's tests that move on to the next rung
+size_t fidelity_schedule::promoted(size_t a_tested) const
+{
+    size_t result = static_cast<size_t>(ceil(a_tested * m_promote - 1e-9));
+    return max(static_cast<size_t>(1),min(result,a_tested));
+}
+
+// count the tests run at a rung
+void fidelity_schedule::count(size_t a_rung, size_t a_tests)
+{
+    if (a_rung < m_gen_tests.size())
+        m_gen_tests[a_rung] += a_tests;
+}
+
+// description for the configuration report
+string fidelity_schedule::get_description() const
+{
+    if (!is_enabled())
+        return string("disabled");
+
+    ostringstream result;
+    result << "rungs at ";
+
+    for (size_t n = 0; n < m_scales.size(); ++n)
+        result << ((n > 0) ? ", " : "") << setprecision(3) << m_scales[n];
+
+    result << " of the workload, best " << (m_promote * 100.0) << "% promoted";
+    return result.str();
+}
+
+// tests per rung for the current generation
+string fidelity_schedule::get_stats_text() const
+{
+    ostringstream result;
+    double cost = 0.0;
+
+    result << "multi-fidelity:";
+
+    for (size_t n = 0; n < m_scales.size(); ++n)
+    {
+        result << ((n > 0) ? "," : "") << " " << m_gen_tests[n] << " tests at " << setprecision(3) << m_scales[n];
+        cost += m_gen_tests[n] * m_scales[n];
+    }
+
+    result << "; workload of " << fixed << setprecision(1) << cost << " full tests";
+
+    if (m_gen_tests[0] > 0)
+        result << " (" << (100.0 * cost / m_gen_tests[0]) << "%)";
+
+    result << "\n";
+    return result.str();
+}
+
+// begin counting a new generation
+void fidelity_schedule::reset_generation_stats()
+{
+    m_gen_tests.assign(m_scales.size(),0);
+}
+
+//----------------------------------------------------------
+// run checkpoint
+
+// identification of checkpoint files
+static const char   CHECKPOINT_MAGIC[8] = { 'A', 'C', 'O', 'V', 'E', 'A', 'C', 'K' };
+static const uint32_t CHECKPOINT_VERSION = 4;   // version 1 lacks operator rates,
+                                                //   version 2 the offspring history,
+                                                //   version 3 the configuration fingerprint
+
+// seed used after a given generation
+static uint32_t generation_seed(uint32_t a_base_seed, size_t a_generation)
+{
+    uint32_t seed = a_base_seed ^ static_cast<uint32_t>(a_generation * 2654435761UL);
+    return (seed != 0) ? seed : 1;
+}
+
+// identity of a configuration's evolvable options: a hash of each
+//   option's type and choices, in order, so that saved or migrating
+//   options are never read into a different configuration
+static uint64_t options_fingerprint(const application & a_target)
+{
+    chromosome options = a_target.get_options();
+    uint64_t hash = FNV_OFFSET;
+
+    for (int n = 0; n < options.size(); ++n)
+    {
+        const tuning_option * tuning  = dynamic_cast<const tuning_option *>(options[n]);
+        const enum_option *   choices = dynamic_cast<const enum_option *>(options[n]);
+
+        unsigned char type = (tuning != NULL) ? 't' : ((choices != NULL) ? 'e' : 's');
+        hash = fnv1a(hash,&type,sizeof(type));
+
+        vector<string> names = options[n]->get_choices();
+
+        for (size_t c = 0; c < names.size(); ++c)
+            hash = fnv1a(hash,reinterpret_cast<const unsigned char *>(names[c].c_str()),names[c].size() + 1);
+
+        if (tuning != NULL)
+        {
+            int32_t range[4] = { tuning->get_default(), tuning->get_min_value(), tuning->get_max_value(), tuning->get_step() };
+            hash = fnv1a(hash,reinterpret_cast<const unsigned char *>(range),sizeof(range));
+        }
+    }
+
+    return hash;
+}
+
+// write the settings of a list of options
+static void write_options(FILE * a_file, const chromosome & a_options)
+{
+    write_value<uint64_t>(a_file,a_options.size());
+
+    for (int n = 0; n < a_options.size(); ++n)
+    {
+        const tuning_option * tuning = dynamic_cast<const tuning_option *>(a_options[n]);
+
+        write_value<uint8_t>(a_file,a_options[n]->is_enabled() ? 1 : 0);
+        write_value<int32_t>(a_file,a_options[n]->get_setting());
+        write_value<int32_t>(a_file,(tuning != NULL) ? tuning->get_value() : 0);
+    }
+}
+
+// read the settings of a list of options into a matching list
+static void read_options(FILE * a_file, chromosome & a_options)
+{
+    if (read_value<uint64_t>(a_file) != a_options.size())
+        throw runtime_error("checkpoint options do not match configuration");
+
+    for (int n = 0; n < a_options.size(); ++n)
+    {
+        bool    enabled = (read_value<uint8_t>(a_file) != 0);
+        int32_t setting = read_value<int32_t>(a_file);
+        int32_t value   = read_value<int32_t>(a_file);
+
+        a_options[n]->set_enabled(enabled);
+
+        enum_option * choices = dynamic_cast<enum_option *>(a_options[n]);
+
+        if (choices != NULL)
+            choices->set_setting(setting);
+
+        tuning_option * tuning = dynamic_cast<tuning_option *>(a_options[n]);
+
+        if (tuning != NULL)
+            tuning->set_value(value);
+    }
+}
+
+// creation constructor
+run_checkpoint::run_checkpoint(const application & a_target,
+                               const string &      a_file_name,
+                               size_t              a_every,
+                               double              a_minutes,
+                               fitness_cache *     a_cache,
+                               surrogate_model *   a_surrogate,
+                               diversity_controller * a_diversity,
+                               offspring_filter *  a_filter)
+  : m_target(a_target),
+    m_file_name(a_file_name),
+    m_every(a_every),
+    m_minutes(a_minutes),
+    m_last_save(time(NULL)),
+    m_cache(a_cache),
+    m_surrogate(a_surrogate),
+    m_diversity(a_diversity),
+    m_filter(a_filter),
+    m_base_seed(libevocosm::globals::get_seed()),
+    m_replaying(false),
+    m_populations(),
+    m_opt_counts()
+{
+    if (m_every < 1)
+        m_every = 1;
+}
+
+// load a saved run; returns the generation being resumed
+size_t run_checkpoint::load(const string & a_file_name,
+                            size_t a_number_of_populations,
+                            size_t a_population_size)
+{
+    FILE * file = fopen(a_file_name.c_str(),"rb");
+
+    if (file == NULL)
+        throw runtime_error("unable to open checkpoint file");
+
+    size_t generation = 0;
+
+    try
+    {
+        char magic[sizeof(CHECKPOINT_MAGIC)];
+
+        if ((fread(magic,1,sizeof(magic),file) != sizeof(magic))
+        ||  (0 != memcmp(magic,CHECKPOINT_MAGIC,sizeof(magic))))
+            throw runtime_error("not an acovea checkpoint file");
+
+        uint32_t version = read_value<uint32_t>(file);
+
+        if ((version < 1) || (version > CHECKPOINT_VERSION))
+            throw runtime_error("unsupported acovea checkpoint version");
+
+        if ((version >= 4) && (read_value<uint64_t>(file) != options_fingerprint(m_target)))
+            throw runtime_error("checkpoint was saved with a different configuration");
+
+        m_base_seed = read_value<uint32_t>(file);
+        generation  = read_value<uint64_t>(file);
+
+        if ((read_value<uint64_t>(file) != a_number_of_populations)
+        ||  (read_value<uint64_t>(file) != a_population_size))
+            throw runtime_error("checkpoint populations do not match command line");
+
+        // organisms
+        m_populations.clear();
+        m_populations.resize(a_number_of_populations);
+
+        for (size_t p = 0; p < a_number_of_populations; ++p)
+        {
+            uint64_t count = read_value<uint64_t>(file);
+
+            for (uint64_t n = 0; n < count; ++n)
+            {
+                acovea_organism org(m_target,m_target.get_options());
+                org.fitness()   = read_value<double>(file);
+                org.run_time()  = read_value<double>(file);
+                org.code_size() = read_value<double>(file);
+                read_options(file,org.genes());
+                m_populations[p].push_back(org);
+            }
+        }
+
+        // reporter statistics
+        uint64_t rows = read_value<uint64_t>(file);
+        uint64_t cols = read_value<uint64_t>(file);
+
+        m_opt_counts.assign(rows,vector<unsigned long>(cols,0UL));
+
+        for (uint64_t r = 0; r < rows; ++r)
+        {
+            for (uint64_t c = 0; c < cols; ++c)
+                m_opt_counts[r][c] = read_value<uint64_t>(file);
+        }
+
+        // evaluation cache and surrogate model, if they were in use
+        if (read_value<uint8_t>(file) != 0)
+        {
+            if (m_cache != NULL)
+                m_cache->load(file);
+            else
+                fitness_cache().load(file);
+        }
+
+        if (read_value<uint8_t>(file) != 0)
+        {
+            if (m_surrogate != NULL)
+                m_surrogate->load(file);
+            else
+                surrogate_model(m_target).load(file);
+        }
+
+        // adjusted operator rates
+        if (version >= 2)
+        {
+            if (read_value<uint8_t>(file) != 0)
+            {
+                if (m_diversity != NULL)
+                    m_diversity->load(file);
+                else
+                {
+                    read_value<double>(file);
+                    read_value<double>(file);
+                }
+            }
+        }
+
+        // genomes already tested
+        if ((version >= 3) && (read_value<uint8_t>(file) != 0) && (m_filter != NULL))
+            m_filter->load(file);
+    }
+    catch (...)
+    {
+        fclose(file);
+        throw;
+    }
+
+    fclose(file);
+
+    // the generation in the checkpoint is reported again, without testing
+    libevocosm::globals::set_random_seed(m_base_seed);
+    m_replaying = true;
+
+    return generation;
+}
+
+// hand out the next restored population
+bool run_checkpoint::restore_population(vector<acovea_organism> & a_population)
+{
+    if (m_populations.empty())
+        return false;
+
+    a_population.insert(a_population.end(),m_populations.front().begin(),m_populations.front().end());
+    m_populations.erase(m_populations.begin());
+
+    return true;
+}
+
+// end of a generation: reseed, and save if a checkpoint is due
+void run_checkpoint::generation_complete(const vector< vector<acovea_organism> > & a_populations,
+                                         size_t a_generation,
+                                         const vector< vector<unsigned long> > & a_opt_counts)
+{
+    if (!is_enabled())
+        return;
+
+    // a replayed generation was saved already
+    bool due = !m_replaying
+            && (((a_generation % m_every) == 0)
+            ||  ((m_minutes > 0.0) && (difftime(time(NULL),m_last_save) >= m_minutes * 60.0)));
+
+    m_replaying = false;
+
+    // what follows depends only on the seed and the generation
+    libevocosm::globals::set_random_seed(generation_seed(m_base_seed,a_generation));
+
+    if (due)
+    {
+        save(a_populations,a_generation,a_opt_counts);
+        m_last_save = time(NULL);
+    }
+}
+
+// write the state of the run
+void run_checkpoint::save(const vector< vector<acovea_organism> > & a_populations,
+                          size_t a_generation,
+                          const vector< vector<unsigned long> > & a_opt_counts) const
+{
+    // write a new file, then replace the old one, so a crash leaves a valid checkpoint
+    string temp_name = m_file_name + ".new";
+    FILE * file = fopen(temp_name.c_str(),"wb");
+
+    if (file == NULL)
+        throw runtime_error("unable to create checkpoint file");
+
+    try
+    {
+        fwrite(CHECKPOINT_MAGIC,1,sizeof(CHECKPOINT_MAGIC),file);
+        write_value<uint32_t>(file,CHECKPOINT_VERSION);
+        write_value<uint64_t>(file,options_fingerprint(m_target));
+        write_value<uint32_t>(file,m_base_seed);
+        write_value<uint64_t>(file,a_generation);
+        write_value<uint64_t>(file,a_populations.size());
+        write_value<uint64_t>(file,a_populations.empty() ? 0 : a_populations[0].size());
+
+        for (size_t p = 0; p < a_populations.size(); ++p)
+        {
+            write_value<uint64_t>(file,a_populations[p].size());
+
+            for (vector< acovea_organism >::const_iterator org = a_populations[p].begin(); org != a_populations[p].end(); ++org)
+            {
+                write_value<double>(file,org->fitness());
+                write_value<double>(file,org->run_time());
+                write_value<double>(file,org->code_size());
+                write_options(file,org->genes());
+            }
+        }
+
+        write_value<uint64_t>(file,a_opt_counts.size());
+        write_value<uint64_t>(file,a_opt_counts.empty() ? 0 : a_opt_counts[0].size());
+
+        for (size_t r = 0; r < a_opt_counts.size(); ++r)
+        {
+            for (size_t c = 0; c < a_opt_counts[r].size(); ++c)
+                write_value<uint64_t>(file,a_opt_counts[r][c]);
+        }
+
+        write_value<uint8_t>(file,(m_cache != NULL) ? 1 : 0);
+
+        if (m_cache != NULL)
+            m_cache->save(file);
+
+        write_value<uint8_t>(file,(m_surrogate != NULL) ? 1 : 0);
+
+        if (m_surrogate != NULL)
+            m_surrogate->save(file);
+
+        write_value<uint8_t>(file,(m_diversity != NULL) ? 1 : 0);
+
+        if (m_diversity != NULL)
+            m_diversity->save(file);
+
+        write_value<uint8_t>(file,(m_filter != NULL) ? 1 : 0);
+
+        if (m_filter != NULL)
+            m_filter->save(file);
+    }
+    catch (...)
+    {
+        fclose(file);
+        remove(temp_name.c_str());
+        throw;
+    }
+
+    if (fclose(file) != 0)
+        throw runtime_error("unable to write checkpoint");
+
+    if (rename(temp_name.c_str(),m_file_name.c_str()) != 0)
+        throw runtime_error("unable to replace checkpoint file");
+}
+
+//----------------------------------------------------------
+// migrant transport
+
+static const char MIGRANT_MAGIC[8] = { 'A', 'C', 'O', 'V', 'E', 'A', 'M', 'G' };
+
+// largest message accepted from a peer
+static const size_t MAX_MIGRANT_MESSAGE = 65536;
+
+// create a transport from an address
+migrant_transport * migrant_transport::create(const string & a_address,
+                                              const vector<string> & a_peers)
+{
+    return new datagram_transport(a_address,a_peers);
+}
+
+// translate an address to a socket address
+size_t datagram_transport::resolve(const string & a_address, struct sockaddr_storage & a_result, int & a_family)
+{
+    memset(&a_result,0,sizeof(a_result));
+
+    if (a_address.compare(0,5,"unix:") == 0)
+    {
+        string path = a_address.substr(5);
+        struct sockaddr_un * addr = reinterpret_cast<struct sockaddr_un *>(&a_result);
+
+        if (path.empty() || (path.size() >= sizeof(addr->sun_path)))
+            throw runtime_error("invalid island socket path: " + a_address);
+
+        addr->sun_family = AF_UNIX;
+        strcpy(addr->sun_path,path.c_str());
+        a_family = AF_UNIX;
+        return sizeof(struct sockaddr_un);
+    }
+
+    if (a_address.compare(0,4,"udp:") == 0)
+    {
+        string::size_type colon = a_address.rfind(':');
+        string host = a_address.substr(4,colon - 4);
+        int port = atoi(a_address.c_str() + colon + 1);
+        struct sockaddr_in * addr = reinterpret_cast<struct sockaddr_in *>(&a_result);
+
+        if (host.empty())
+            host = "127.0.0.1";
+
+        if ((colon < 4) || (port <= 0) || (port > 65535) || (inet_pton(AF_INET,host.c_str(),&addr->sin_addr) != 1))
+            throw runtime_error("invalid island address: " + a_address);
+
+        addr->sin_family = AF_INET;
+        addr->sin_port   = htons(static_cast<uint16_t>(port));
+        a_family = AF_INET;
+        return sizeof(struct sockaddr_in);
+    }
+
+    throw runtime_error("island address must begin with unix: or udp: -- " + a_address);
+}
+
+// creation constructor
+datagram_transport::datagram_transport(const string & a_address, const vector<string> & a_peers)
+  : m_socket(-1),
+    m_address(a_address),
+    m_peers(),
+    m_peer_lengths()
+{
+    struct sockaddr_storage self;
+    int family;
+    size_t self_length = resolve(a_address,self,family);
+
+    for (vector<string>::const_iterator peer = a_peers.begin(); peer != a_peers.end(); ++peer)
+    {
+        struct sockaddr_storage addr;
+        int peer_family;
+        size_t length = resolve(*peer,addr,peer_family);
+
+        if (peer_family != family)
+            throw runtime_error("island peers must use the same transport: " + *peer);
+
+        m_peers.push_back(addr);
+        m_peer_lengths.push_back(length);
+    }
+
+    m_socket = socket(family,SOCK_DGRAM,0);
+
+    if (m_socket < 0)
+        throw runtime_error("unable to create island socket");
+
+    // a stale socket file is left behind by a process that was killed
+    if (family == AF_UNIX)
+        unlink(reinterpret_cast<struct sockaddr_un *>(&self)->sun_path);
+
+    if ((bind(m_socket,reinterpret_cast<struct sockaddr *>(&self),self_length) != 0)
+    ||  (fcntl(m_socket,F_SETFL,fcntl(m_socket,F_GETFL) | O_NONBLOCK) != 0))
+    {
+        close(m_socket);
+        throw runtime_error("unable to bind island socket: " + a_address);
+    }
+}
+
+// destructor
+datagram_transport::~datagram_transport()
+{
+    close(m_socket);
+
+    if (m_address.compare(0,5,"unix:") == 0)
+        unlink(m_address.c_str() + 5);
+}
+
+// send a message to every peer
+void datagram_transport::send(const string & a_message)
+{
+    // a peer that is busy, full, or gone simply misses this message
+    for (size_t n = 0; n < m_peers.size(); ++n)
+        sendto(m_socket,a_message.data(),a_message.size(),MSG_DONTWAIT,
+               reinterpret_cast<const struct sockaddr *>(&m_peers[n]),m_peer_lengths[n]);
+}
+
+// receive a waiting message, if there is one
+bool datagram_transport::receive(string & a_message)
+{
+    static char buffer[MAX_MIGRANT_MESSAGE];
+
+    ssize_t length = recv(m_socket,buffer,sizeof(buffer),MSG_DONTWAIT);
+
+    if (length <= 0)
+        return false;
+
+    a_message.assign(buffer,length);
+    return true;
+}
+
+// description for configuration reports
+string datagram_transport::get_description() const
+{
+    ostringstream text;
+    text << m_address << ", " << m_peers.size() << " peer(s)";
+    return text.str();
+}
+
+//----------------------------------------------------------
+// island migrator
+
+// creation constructor
+island_migrator::island_migrator(migrator< acovea_organism > & a_local,
+                                 migrant_transport & a_transport,
+                                 const application & a_target,
+                                 listener & a_listener,
+                                 size_t a_how_many)
+  : m_local(a_local),
+    m_transport(a_transport),
+    m_target(a_target),
+    m_listener(a_listener),
+    m_how_many(a_how_many),
+    m_fingerprint(options_fingerprint(a_target))
+{
+    // nada
+}
+
+// convert an organism to a message
+string island_migrator::encode(const acovea_organism & a_org) const
+{
+    char * data = NULL;
+    size_t size = 0;
+    FILE * stream = open_memstream(&data,&size);
+
+    if (stream == NULL)
+        throw runtime_error("unable to encode migrant");
+
+    try
+    {
+        fwrite(MIGRANT_MAGIC,sizeof(MIGRANT_MAGIC),1,stream);
+        write_value<uint64_t>(stream,m_fingerprint);
+        write_value<double>(stream,a_org.fitness());
+        write_options(stream,a_org.genes());
+    }
+    catch (...)
+    {
+        fclose(stream);
+        free(data);
+        throw;
+    }
+
+    fclose(stream);
+    string result(data,size);
+    free(data);
+
+    return result;
+}
+
+// convert a message to an organism
+bool island_migrator::decode(const string & a_message, acovea_organism & a_org) const
+{
+    if ((a_message.size() < sizeof(MIGRANT_MAGIC))
+    ||  (memcmp(a_message.data(),MIGRANT_MAGIC,sizeof(MIGRANT_MAGIC)) != 0))
+        return false;
+
+    FILE * stream = fmemopen(const_cast<char *>(a_message.data() + sizeof(MIGRANT_MAGIC)),
+                             a_message.size() - sizeof(MIGRANT_MAGIC),"rb");
+
+    if (stream == NULL)
+        return false;
+
+    bool result = true;
+
+    // a truncated message or one from a differently-configured island is ignored
+    try
+    {
+        if (read_value<uint64_t>(stream) != m_fingerprint)
+            throw runtime_error("migrant options do not match configuration");
+
+        a_org.fitness() = read_value<double>(stream);
+        read_options(stream,a_org.genes());
+    }
+    catch (runtime_error &)
+    {
+        result = false;
+    }
+
+    fclose(stream);
+    return result;
+}
+
+// ordering of organism indices by fitness
+struct fitness_index_order
+{
+    const vector<acovea_organism> & m_population;
+
+    fitness_index_order(const vector<acovea_organism> & a_population)
+      : m_population(a_population)
+    {
+        // nada
+    }
+
+    bool operator () (size_t a_left, size_t a_right) const
+    {
+        return m_population[a_left].fitness() < m_population[a_right].fitness();
+    }
+};
+
+// migrate organisms
+void island_migrator::migrate(vector< vector< acovea_organism > > & a_populations)
+{
+    // exchange among our own populations first
+    m_local.migrate(a_populations);
+
+    // send copies of the best organisms from random populations
+    size_t sent = 0;
+
+    for (size_t n = 0; n < m_how_many; ++n)
+    {
+        vector<acovea_organism> & pop = a_populations[g_random.get_index(a_populations.size())];
+
+        if (pop.empty())
+            continue;
+
+        size_t best = 0;
+
+        for (size_t i = 1; i < pop.size(); ++i)
+        {
+            if (pop[i].fitness() < pop[best].fitness())
+                best = i;
+        }
+
+        m_transport.send(encode(pop[best]));
+        ++sent;
+    }
+
+    // immigrants replace the worst organisms of random populations; no
+    // more than half of a population is replaced in one generation
+    vector< vector<size_t> > worst(a_populations.size());
+
+    for (size_t p = 0; p < a_populations.size(); ++p)
+    {
+        for (size_t i = 0; i < a_populations[p].size(); ++i)
+            worst[p].push_back(i);
+
+        sort(worst[p].begin(),worst[p].end(),fitness_index_order(a_populations[p]));
+        worst[p].erase(worst[p].begin(),worst[p].begin() + (worst[p].size() + 1) / 2);
+    }
+
+    size_t received = 0;
+    size_t rejected = 0;
+    size_t dropped  = 0;
+    string message;
+
+    // take everything waiting; whatever is still in transit arrives next time
+    while (m_transport.receive(message))
+    {
+        acovea_organism immigrant(m_target,m_target.get_options());
+
+        if (!decode(message,immigrant))
+        {
+            ++rejected;
+            continue;
+        }
+
+        size_t p = g_random.get_index(a_populations.size());
+
+        if (worst[p].empty())
+        {
+            ++dropped;
+            continue;
+        }
+
+        a_populations[p][worst[p].back()] = immigrant;
+        worst[p].pop_back();
+        ++received;
+    }
+
+    ostringstream text;
+    text << "island migration: " << sent << " sent, " << received << " received";
+
+    if (dropped > 0)
+        text << ", " << dropped << " dropped";
+
+    if (rejected > 0)
+        text << ", " << rejected << " rejected";
+
+    text << "\n";
+    m_listener.report(text.str());
+}
+
+//----------------------------------------------------------
+// latency histogram
+
+// constructor
+latency_histogram::latency_histogram()
+{
+    reset();
+}
+
+// add the counts of another histogram
+void latency_histogram::add(const latency_histogram & a_source)
+{
+    for (int n = 0; n < BUCKETS; ++n)
+        m_counts[n] += a_source.m_counts[n];
+
+    m_count += a_source.m_count;
+    m_total += a_source.m_total;
+
+    if (a_source.m_min < m_min)
+        m_min = a_source.m_min;
+
+    if (a_source.m_max > m_max)
+        m_max = a_source.m_max;
+}
+
+// forget all values
+void latency_histogram::reset()
+{
+    memset(m_counts,0,sizeof(m_counts));
+    m_count = 0;
+    m_total = 0;
+    m_min   = numeric_limits<uint64_t>::max();
+    m_max   = 0;
+}
+
+// range of a bucket
+uint64_t latency_histogram::bucket_low(int a_bucket)
+{
+    if (a_bucket < SUB_BUCKETS)
+        return static_cast<uint64_t>(a_bucket);
+
+    int exponent = a_bucket / SUB_BUCKETS + 3;
+    return static_cast<uint64_t>(SUB_BUCKETS + a_bucket % SUB_BUCKETS) << (exponent - 4);
+}
+
+uint64_t latency_histogram::bucket_high(int a_bucket)
+{
+    if (a_bucket < SUB_BUCKETS)
+        return static_cast<uint64_t>(a_bucket);
+
+    int exponent = a_bucket / SUB_BUCKETS + 3;
+    return bucket_low(a_bucket) + (static_cast<uint64_t>(1) << (exponent - 4)) - 1;
+}
+
+// value below which the given percentage of values fall
+uint64_t latency_histogram::percentile(double a_percent) const
+{
+    if (m_count == 0)
+        return 0;
+
+    uint64_t wanted = static_cast<uint64_t>(ceil(a_percent / 100.0 * static_cast<double>(m_count)));
+
+    if (wanted < 1)
+        wanted = 1;
+
+    uint64_t seen = 0;
+
+    for (int n = 0; n < BUCKETS; ++n)
+    {
+        seen += m_counts[n];
+
+        // report the top of the bucket, but never more than the largest value
+        if (seen >= wanted)
+            return (bucket_high(n) < m_max) ? bucket_high(n) : m_max;
+    }
+
+    return m_max;
+}
+
+// write non-empty buckets, one "prefix low high count" line each
+void latency_histogram::write_buckets(FILE * a_file, const char * a_prefix) const
+{
+    for (int n = 0; n < BUCKETS; ++n)
+    {
+        if (m_counts[n] > 0)
+            fprintf(a_file,"%s %llu %llu %llu\n",a_prefix,
+                    static_cast<unsigned long long>(bucket_low(n)),
+                    static_cast<unsigned long long>(bucket_high(n)),
+                    static_cast<unsigned long long>(m_counts[n]));
+    }
+}
+
+//----------------------------------------------------------
+// phase profile
+
+// constructor (one per process)
+phase_profile::phase_profile()
+{
+    // nada
+}
+
+// the profile for this process
+phase_profile & phase_profile::global()
+{
+    static phase_profile profile;
+    return profile;
+}
+
+// monotonic time, in nanoseconds
+uint64_t phase_profile::now()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ULL + static_cast<uint64_t>(now.tv_nsec);
+}
+
+// name of a phase
+const char * phase_profile::get_name(run_phase a_phase)
+{
+    static const char * PHASE_NAME[PHASE_COUNT] =
+    {
+        "test", "fork", "compile", "run", "file I/O", "cache", "yield", "breed", "mutate", "report"
+    };
+
+    return PHASE_NAME[a_phase];
+}
+
+// is timing compiled in?
+bool phase_profile::is_enabled()
+{
+#if defined(ACOVEA_NO_TIMING)
+    return false;
+#else
+    return true;
+#endif
+}
+
+// fold the current generation into the run totals
+void phase_profile::end_generation()
+{
+    for (int n = 0; n < PHASE_COUNT; ++n)
+    {
+        m_run[n].add(m_generation[n]);
+        m_generation[n].reset();
+    }
+}
+
+// a duration in nanoseconds, as three significant digits and a unit
+static string format_duration(uint64_t a_nanoseconds)
+{
+    static const char * UNIT[4] = { "ns", "us", "ms", "s" };
+
+    double value = static_cast<double>(a_nanoseconds);
+    int unit = 0;
+
+    while ((value >= 1000.0) && (unit < 3))
+    {
+        value /= 1000.0;
+        ++unit;
+    }
+
+    char text[32];
+    snprintf(text,32,"%.3g%s",value,UNIT[unit]);
+    return string(text);
+}
+
+// table of counts, percentiles and totals for the current generation or the whole run
+string phase_profile::get_stats_text(bool a_whole_run) const
+{
+    if (!is_enabled())
+        return string("phase timing: not compiled in\n");
+
+    // a run's totals include a generation not yet folded in
+    latency_histogram totals[PHASE_COUNT];
+
+    if (a_whole_run)
+    {
+        for (int n = 0; n < PHASE_COUNT; ++n)
+        {
+            totals[n].add(m_run[n]);
+            totals[n].add(m_generation[n]);
+        }
+    }
+
+    const latency_histogram * histograms = a_whole_run ? totals : m_generation;
+    ostringstream text;
+
+    text << "phase timing (" << (a_whole_run ? "run" : "generation") << "):\n"
+         << right << setw(10) << "phase" << setw(9) << "count" << setw(9) << "p50"
+         << setw(9) << "p90" << setw(9) << "p99" << setw(9) << "max" << setw(9) << "total" << "\n";
+
+    for (int n = 0; n < PHASE_COUNT; ++n)
+    {
+        const latency_histogram & histogram = histograms[n];
+
+        if (histogram.count() == 0)
+            continue;
+
+        text << setw(10) << get_name(static_cast<run_phase>(n))
+             << setw(9) << histogram.count()
+             << setw(9) << format_duration(histogram.percentile(50.0))
+             << setw(9) << format_duration(histogram.percentile(90.0))
+             << setw(9) << format_duration(histogram.percentile(99.0))
+             << setw(9) << format_duration(histogram.max())
+             << setw(9) << format_duration(histogram.total()) << "\n";
+    }
+
+    return text.str();
+}
+
+// write the run's summary and histograms to a file
+void phase_profile::write(const string & a_file_name) const
+{
+    FILE * file = fopen(a_file_name.c_str(),"w");
+
+    if (file == NULL)
+        throw runtime_error("unable to write phase timing to " + a_file_name);
+
+    // the current generation may not have been folded in yet
+    latency_histogram totals[PHASE_COUNT];
+
+    for (int n = 0; n < PHASE_COUNT; ++n)
+    {
+        totals[n].add(m_run[n]);
+        totals[n].add(m_generation[n]);
+    }
+
+    fprintf(file,"# ACOVEA phase timing; all times in nanoseconds\n"
+                 "# summary phase count min p50 p90 p99 p99.9 max total\n");
+
+    for (int n = 0; n < PHASE_COUNT; ++n)
+    {
+        fprintf(file,"summary \"%s\" %llu %llu %llu %llu %llu %llu %llu %llu\n",
+                get_name(static_cast<run_phase>(n)),
+                static_cast<unsigned long long>(totals[n].count()),
+                static_cast<unsigned long long>(totals[n].min()),
+                static_cast<unsigned long long>(totals[n].percentile(50.0)),
+                static_cast<unsigned long long>(totals[n].percentile(90.0)),
+                static_cast<unsigned long long>(totals[n].percentile(99.0)),
+                static_cast<unsigned long long>(totals[n].percentile(99.9)),
+                static_cast<unsigned long long>(totals[n].max()),
+                static_cast<unsigned long long>(totals[n].total()));
+    }
+
+    fprintf(file,"# bucket phase low high count\n");
+
+    for (int n = 0; n < PHASE_COUNT; ++n)
+    {
+        string prefix = string("bucket \"") + get_name(static_cast<run_phase>(n)) + "\"";
+        totals[n].write_buckets(file,prefix.c_str());
+    }
+
+    fclose(file);
+}
+
+//----------------------------------------------------------
+// trace writer
+
+// constructor (one per process)
+trace_writer::trace_writer()
+  : m_file(NULL),
+    m_origin(0),
+    m_pid(0),
+    m_named_lanes(),
+    m_tests(0),
+    m_test(0),
+    m_genome(0),
+    m_keeping(false),
+    m_kept()
+{
+    // nada
+}
+
+// the writer for this process
+trace_writer & trace_writer::global()
+{
+    static trace_writer writer;
+    return writer;
+}
+
+// start a trace
+void trace_writer::open(const string & a_file_name)
+{
+    m_file = fopen(a_file_name.c_str(),"w");
+
+    if (m_file == NULL)
+        throw runtime_error("unable to create trace file " + a_file_name);
+
+    m_origin = phase_profile::now();
+    m_pid    = getpid();
+
+    // the array format, which loads even if the run never finishes it
+    fprintf(m_file,"[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"acovea\"}}",
+            static_cast<int>(m_pid));
+}
+
+// finish a trace
+void trace_writer::close()
+{
+    if ((m_file == NULL) || m_keeping)
+        return;
+
+    fprintf(m_file,"\n]\n");
+    fclose(m_file);
+    m_file = NULL;
+}
+
+// start a test, which labels the spans inside it
+size_t trace_writer::begin_test(const chromosome & a_genes)
+{
+    m_test   = ++m_tests;
+    m_genome = offspring_filter::canonical_hash(a_genes);
+    return m_test;
+}
+
+// end a test
+void trace_writer::end_test()
+{
+    m_test   = 0;
+    m_genome = 0;
+}
+
+// in a forked test process, keep spans for the parent
+void trace_writer::begin_child()
+{
+    m_keeping = true;
+    m_kept.clear();
+}
+
+// add a span on the main lane, or keep it in a test process
+void trace_writer::span(run_phase a_phase, uint64_t a_start, uint64_t a_end)
+{
+    // yields only say that a wait was polled; the wait itself is the span
+    if (a_phase == PHASE_YIELD)
+        return;
+
+    trace_span span = { a_phase, a_start, a_end, m_test, m_genome };
+
+    if (m_keeping)
+        m_kept.push_back(span);
+    else
+        write_event(phase_profile::get_name(a_phase),span,0);
+}
+
+// write spans from a test process on the lane of its slot
+void trace_writer::add_spans(const vector<trace_span> & a_spans, size_t a_lane)
+{
+    for (vector<trace_span>::const_iterator span = a_spans.begin(); span != a_spans.end(); ++span)
+        write_event(phase_profile::get_name(span->m_phase),*span,a_lane);
+}
+
+// write a span for a whole test on the lane of its slot
+void trace_writer::add_test(size_t a_test, uint64_t a_start, uint64_t a_end, size_t a_lane)
+{
+    trace_span span = { PHASE_TEST, a_start, a_end, a_test, 0 };
+    write_event(phase_profile::get_name(PHASE_TEST),span,a_lane);
+}
+
+// write one complete event, naming its lane first if needed
+void trace_writer::write_event(const char * a_name, const trace_span & a_span, size_t a_lane)
+{
+    if ((m_file == NULL) || m_keeping)
+        return;
+
+    if (m_named_lanes.insert(a_lane).second)
+    {
+        if (a_lane == 0)
+            fprintf(m_file,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"main\"}}",
+                    static_cast<int>(m_pid));
+        else
+            fprintf(m_file,",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%lu,\"args\":{\"name\":\"test slot %lu\"}}",
+                    static_cast<int>(m_pid),static_cast<unsigned long>(a_lane),static_cast<unsigned long>(a_lane));
+    }
+
+    // times are in microseconds from the start of the trace
+    double start    = static_cast<double>(a_span.m_start - m_origin) / 1000.0;
+    double duration = static_cast<double>(a_span.m_end - a_span.m_start) / 1000.0;
+
+    fprintf(m_file,",\n{\"name\":\"%s\",\"cat\":\"acovea\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%lu",
+            a_name,start,duration,static_cast<int>(m_pid),static_cast<unsigned long>(a_lane));
+
+    if (a_span.m_test != 0)
+    {
+        fprintf(m_file,",\"args\":{\"test\":%lu",static_cast<unsigned long>(a_span.m_test));
+
+        if (a_span.m_genome != 0)
+            fprintf(m_file,",\"genome\":\"%016llx\"",static_cast<unsigned long long>(a_span.m_genome));
+
+        fprintf(m_file,"}");
+    }
+
+    fprintf(m_file,"}");
+}
+
+//----------------------------------------------------------
+// fitness landscape
+
+acovea_landscape::acovea_landscape(const benchmark_suite & a_suite,
+                                   optimization_mode a_mode,
+                                   const application & a_target,
+                                   acovea_listener & a_listener,
+                                   fitness_cache * a_cache,
+                                   surrogate_model * a_surrogate,
+                                   const run_checkpoint * a_checkpoint,
+                                   fidelity_schedule * a_fidelity,
+                                   profile_cache * a_profiles)
+    : landscape<acovea_organism>(a_listener),
+      m_suite(&a_suite),
+      m_target(a_target),
+      m_mode(a_mode),
+      m_cache(a_cache),
+      m_surrogate(a_surrogate),
+      m_checkpoint(a_checkpoint),
+      m_fidelity(a_fidelity),
+      m_profiles(a_profiles),
+      m_events(a_listener)
+{
+    // nada
+}
+
+acovea_landscape::acovea_landscape(const acovea_landscape & a_source)
+    : landscape<acovea_organism>(a_source),
+      m_suite(a_source.m_suite),
+      m_target(a_source.m_target),
+      m_mode(a_source.m_mode),
+      m_cache(a_source.m_cache),
+      m_surrogate(a_source.m_surrogate),
+      m_checkpoint(a_source.m_checkpoint),
+      m_fidelity(a_source.m_fidelity),
+      m_profiles(a_source.m_profiles),
+      m_events(a_source.m_events)
+{
+    // nada
+}
+
+acovea_landscape & acovea_landscape::operator = (const acovea_landscape & a_source)
+{
+    landscape<acovea_organism>::operator = (a_source);
+    m_suite = a_source.m_suite;
+    m_mode = a_source.m_mode;
+    m_cache = a_source.m_cache;
+    m_surrogate = a_source.m_surrogate;
+    m_checkpoint = a_source.m_checkpoint;
+    m_fidelity = a_source.m_fidelity;
+    m_profiles = a_source.m_profiles;
+    // can't duplicate m_target or m_events since they're references
+    return *this;
+}
+
+acovea_landscape::~acovea_landscape()
+{
+    // nada
+}
+
+// start compiling a program; returns the compiler's process ID
+static pid_t start_compile(const vector<string> & command,
+                           string & command_text)
+{
+    // allocate array of string pointers for exec
+    char ** argv = new char * [command.size() + 1];
+    
+    // create string representing the command
+    command_text.clear();
+
+    // fill list and string versions of command    
+    for (int n = 0; n < command.size(); ++n)
+    {
+        // dupe so we know the string doesn't go away
+        argv[n] = strdup(command[n].c_str());
+        command_text += command[n] + " ";
+    }
+    
+    // terminate argument list
+    argv[command.size()] = NULL;
+
+    // create compile process
+    pid_t child_pid;
+
+    {
+        ACOVEA_TIME_PHASE(fork_timer,PHASE_FORK);
+        child_pid = fork();
+    }
+
+    if (child_pid == 0)
+        execvp(argv[0],argv);
+
+    // the compiler has its own copy; clean up string dupes!
+    for (int n = 0; n < command.size(); ++n)
+        free(argv[n]);
+
+    delete [] argv;
+
+    return child_pid;
+}
+
+// wait for a compile to finish; returns true if the compiler succeeded
+static bool finish_compile(pid_t child_pid,
+                           const string & command_text,
+                           listener & listener,
+                           int * exit_status = NULL)
+{
+    int child_retval;
+
+    while (0 == waitpid(child_pid,&child_retval,WNOHANG))
+    {
+        ACOVEA_TIME_PHASE(yield_timer,PHASE_YIELD);
+        listener.yield();
+    }
+
+    if (exit_status != NULL)
+        *exit_status = child_retval;
+
+    if (child_retval != 0)
+    {
+        // handle application error
+        ostringstream errormsg;
+        errormsg << "\nCOMPILE FAILED:\n" << command_text << endl;
+        listener.report_error(errormsg.str());
+        return false;
+    }
+
+    return true;
+}
+
+// compile a program; returns true if the compiler succeeded
+static bool compile_program(const vector<string> & command,
+                            listener & listener,
+                            string & command_text,
+                            int * exit_status = NULL)
+{
+    ACOVEA_TIME_PHASE(compile_timer,PHASE_COMPILE);
+    pid_t child_pid = start_compile(command,command_text);
+    return finish_compile(child_pid,command_text,listener,exit_status);
+}
+
+// benchmark output kept for finding the result: the start, where a
+//   classic result is, and the end, where a versioned one usually is
+static const size_t RESULT_HEAD = 4096;
+static const size_t RESULT_TAIL = 65536;
+
+// read whatever a program has written so far, without waiting; returns
+//   false at the end of its output
+static bool read_output(int fd, string & output)
+{
+    char buffer[4096];
+
+    while (true)
+    {
+        ssize_t count = read(fd,buffer,sizeof(buffer));
+
+        if (count > 0)
+        {
+            output.append(buffer,count);
+
+            // drop the middle of long output, on a line of its own
+            if (output.size() > RESULT_HEAD + 2 * RESULT_TAIL)
+                output.replace(RESULT_HEAD,output.size() - RESULT_HEAD - RESULT_TAIL,"\n");
+        }
+        else if (count == 0)
+            return false;
+        else
+            return (errno == EAGAIN) || (errno == EINTR);
+    }
+}
+
+//----------------------------------------------------------
+// benchmark runner
+
+// a benchmark's announcement that it serves samples
+static const char SERVER_HELLO[4] = { 'A', 'F', 'S', '1' };
+
+// creation constructor
+benchmark_runner::benchmark_runner(const string & a_program,
+                                   listener & a_listener,
+                                   bool a_fork_server,
+                                   double a_scale)
+  : m_program(a_program),
+    m_listener(a_listener),
+    m_fork_server(a_fork_server),
+    m_scale(a_scale),
+    m_server(0),
+    m_output(-1),
+    m_control(-1),
+    m_status(-1)
+{
+    // nada
+}
+
+// destructor
+benchmark_runner::~benchmark_runner()
+{
+    stop();
+}
+
+// keep a descriptor from other programs, and optionally from waiting
+static void set_descriptor_flags(int fd, bool a_nonblocking)
+{
+    fcntl(fd,F_SETFD,fcntl(fd,F_GETFD) | FD_CLOEXEC);
+
+    if (a_nonblocking)
+        fcntl(fd,F_SETFL,fcntl(fd,F_GETFL) | O_NONBLOCK);
+    else
+        fcntl(fd,F_SETFL,fcntl(fd,F_GETFL) & ~O_NONBLOCK);
+}
+
+// start the program, with its output on a pipe
+pid_t benchmark_runner::launch(bool a_serve, int & a_output, int & a_control, int & a_status_pipe)
+{
+    // run the program; a full workload is the default
+    char scale[32];
+    snprintf(scale,32,"%g",m_scale);
+
+    char * argv[6];
+    int argc = 0;
+    argv[argc++] = strdup(m_program.c_str());
+    argv[argc++] = const_cast<char *>("-ga");
+
+    if (a_serve)
+        argv[argc++] = const_cast<char *>("-fork-server");
+
+    if (m_scale != 1.0)
+    {
+        argv[argc++] = const_cast<char *>("-scale");
+        argv[argc++] = scale;
+    }
+
+    argv[argc] = NULL;
+
+    // constants for I/O descriptors
+    static const int PIPE_IN  = 0;
+    static const int PIPE_OUT = 1;
+
+    // create pipes
+    int output[2];
+    int control[2];
+    int status[2];
+    pipe(output);
+
+    if (a_serve)
+    {
+        pipe(control);
+        pipe(status);
+    }
+
+    // fork and exec program
+    pid_t child_pid;
+
+    {
+        ACOVEA_TIME_PHASE(fork_timer,PHASE_FORK);
+        child_pid = fork();
+    }
+
+    if (child_pid == 0)
+    {
+        // redirect std. output for child
+        close(STDOUT_FILENO);
+        dup2(output[PIPE_OUT],STDOUT_FILENO);
+        close(output[PIPE_IN]);
+        close(output[PIPE_OUT]);
+
+        // a server reads requests and writes results on known descriptors
+        if (a_serve)
+        {
+            dup2(control[PIPE_IN],CONTROL_FD);
+            dup2(status[PIPE_OUT],STATUS_FD);
+            close(control[PIPE_IN]);
+            close(control[PIPE_OUT]);
+            close(status[PIPE_IN]);
+            close(status[PIPE_OUT]);
+        }
+
+        execve(m_program.c_str(),argv,NULL);
+        _exit(127);
+    }
+
+    // free memory
+    free(argv[0]);
+
+    // read output while the program runs, so a chatty one doesn't fill
+    //   the pipe and stall
+    close(output[PIPE_OUT]);
+    a_output = output[PIPE_IN];
+    set_descriptor_flags(a_output,true);
+
+    if (a_serve)
+    {
+        close(control[PIPE_IN]);
+        close(status[PIPE_OUT]);
+        a_control     = control[PIPE_OUT];
+        a_status_pipe = status[PIPE_IN];
+        set_descriptor_flags(a_control,false);
+        set_descriptor_flags(a_status_pipe,true);
+    }
+
+    return child_pid;
+}
+
+// wait for a program to finish, collecting its output
+static void finish_program(pid_t a_pid, int a_output, string & a_text, int & a_status, listener & a_listener)
+{
+    bool reading = true;
+
+    // wait for child to finish
+    while (0 == waitpid(a_pid,&a_status,WNOHANG))
+    {
+        if (reading)
+            reading = read_output(a_output,a_text);
+
+        ACOVEA_TIME_PHASE(yield_timer,PHASE_YIELD);
+        a_listener.yield();
+    }
+
+    // collect the rest of the output
+    set_descriptor_flags(a_output,false);
+
+    while (reading)
+        reading = read_output(a_output,a_text);
+
+    close(a_output);
+}
+
+// run the program once, to completion
+void benchmark_runner::execute(string & a_output, int & a_status)
+{
+    int output;
+    int unused;
+    pid_t child_pid = launch(false,output,unused,unused);
+
+    a_output.clear();
+    finish_program(child_pid,output,a_output,a_status,m_listener);
+}
+
+// read a fixed-size message without waiting forever on a quiet pipe;
+//   returns false if the writer has gone
+static bool read_message(int fd, void * a_message, size_t a_size, int a_output, string & a_text, listener & a_listener)
+{
+    char * message = static_cast<char *>(a_message);
+    size_t got = 0;
+
+    while (got < a_size)
+    {
+        ssize_t count = read(fd,message + got,a_size - got);
+
+        if (count > 0)
+            got += count;
+        else if ((count == 0) || ((errno != EAGAIN) && (errno != EINTR)))
+            return false;
+        else
+        {
+            read_output(a_output,a_text);
+
+            ACOVEA_TIME_PHASE(yield_timer,PHASE_YIELD);
+            a_listener.yield();
+        }
+    }
+
+    return true;
+}
+
+// start a server
+bool benchmark_runner::start(string & a_output, int & a_status)
+{
+    pid_t child_pid = launch(true,m_output,m_control,m_status);
+    char hello[sizeof(SERVER_HELLO)];
+
+    a_output.clear();
+
+    if (read_message(m_status,hello,sizeof(hello),m_output,a_output,m_listener)
+     && (0 == memcmp(hello,SERVER_HELLO,sizeof(hello))))
+    {
+        m_server = child_pid;
+        return true;
+    }
+
+    // not a server, so this is an ordinary run
+    close(m_control);
+    close(m_status);
+    finish_program(child_pid,m_output,a_output,a_status,m_listener);
+    m_control = -1;
+    m_status  = -1;
+    m_output  = -1;
+    return false;
+}
+
+// have the server fork a sample
+bool benchmark_runner::request(string & a_output, int & a_status)
+{
+    // discard what the server wrote while initializing
+    read_output(m_output,a_output);
+    a_output.clear();
+
+    // a server that has died would raise SIGPIPE
+    struct sigaction ignore;
+    struct sigaction previous;
+    memset(&ignore,0,sizeof(ignore));
+    ignore.sa_handler = SIG_IGN;
+    sigaction(SIGPIPE,&ignore,&previous);
+
+    uint32_t command = 0;
+    bool sent = (write(m_control,&command,sizeof(command)) == sizeof(command));
+
+    sigaction(SIGPIPE,&previous,NULL);
+
+    int32_t status;
+
+    if (!sent || !read_message(m_status,&status,sizeof(status),m_output,a_output,m_listener))
+        return false;
+
+    // the sample has exited, so all of its output is in the pipe
+    read_output(m_output,a_output);
+    a_status = status;
+    return true;
+}
+
+// stop the server
+void benchmark_runner::stop()
+{
+    if (m_server == 0)
+        return;
+
+    // the server exits when its control pipe closes
+    close(m_control);
+    close(m_status);
+
+    string output;
+    int status;
+    finish_program(m_server,m_output,output,status,m_listener);
+
+    m_server  = 0;
+    m_output  = -1;
+    m_control = -1;
+    m_status  = -1;
+}
+
+// run one sample
+void benchmark_runner::run(string & a_output, int & a_status)
+{
+    // the first run tries to start a server
+    if (m_fork_server)
+    {
+        m_fork_server = false;
+
+        // an ordinary run counts, unless it failed (perhaps rejecting the
+        //   server's command-line switch)
+        if (!start(a_output,a_status) && (a_status == 0))
+            return;
+    }
+
+    if (m_server != 0)
+    {
+        if (request(a_output,a_status))
+            return;
+
+        // the server has died; carry on without it
+        stop();
+    }
+
+    execute(a_output,a_status);
+}
+
+// run a compiled program once and return its fitness
+static double run_program(const string & temp_name,
+                          const string & command_text,
+                          listener & listener,
+                          optimization_mode mode,
+                          const fitness_formula & formula,
+                          int * exit_status = NULL,
+                          benchmark_result * result = NULL,
+                          benchmark_runner * runner = NULL)
+{
+    ACOVEA_TIME_PHASE(run_timer,PHASE_RUN);
+
+    // resulting fitness
+    double fitness = 0.0;
+
+    // run the program
+    string output;
+    int child_retval;
+    benchmark_runner single(temp_name,listener);
+
+    ((runner != NULL) ? *runner : single).run(output,child_retval);
+
+    if (exit_status != NULL)
+        *exit_status = child_retval;
+
+    benchmark_result parsed;
+    bool reported = parsed.parse(output);
+
+    if (result != NULL)
+        *result = parsed;
+
+    if ((mode == OPTIMIZE_SPEED) || (mode == OPTIMIZE_PARETO))
+    {
+        string missing;
+
+        if (child_retval != 0)
+        {
+            // handle application error
+            ostringstream errormsg;
+            errormsg << "\nRUN FAILED:\n" << command_text << endl;
+            listener.report_error(errormsg.str());
+            fitness = BOGUS_RUN_TIME;
+        }
+        else if (!reported)
+        {
+            ostringstream errormsg;
+            errormsg << "\nNO RESULT REPORTED:\n" << command_text << endl;
+            listener.report_error(errormsg.str());
+            fitness = BOGUS_RUN_TIME;
+        }
+        else if (!formula.evaluate(parsed,fitness,missing))
+        {
+            ostringstream errormsg;
+            errormsg << "\nRESULT LACKS METRIC " << missing << ":\n" << command_text << endl;
+            listener.report_error(errormsg.str());
+            fitness = BOGUS_RUN_TIME;
+        }
+    }
+    else // OPTIMIZE_RETVAL
+    {
+        fitness = (double)child_retval;
+    }
+
+    return fitness;
+}
+
+// check a result against its input's reference checksum, reporting a
+//   mismatch
+static bool verify_result(const benchmark_suite & suite,
+                          size_t input,
+                          const map<string,string> & fields,
+                          const string & command_text,
+                          listener & listener)
+{
+    if (suite.verify(input,fields))
+        return true;
+
+    map<string,string>::const_iterator checksum = fields.find("checksum");
+
+    ostringstream errormsg;
+    errormsg << "\nWRONG RESULT (checksum " << ((checksum != fields.end()) ? checksum->second : string("missing"))
+             << ", expected " << suite.get_checksum(input) << "):\n" << command_text << endl;
+    listener.report_error(errormsg.str());
+    return false;
+}
+
+// a record of a test that hasn't happened yet
+static evaluation_record new_record(const chromosome & options)
+{
+    evaluation_record record;
+    record.m_options         = population_seeder::get_flags(options);
+    record.m_compiled        = false;
+    record.m_exit_status     = 0;
+    record.m_compile_seconds = 0.0;
+    record.m_scale           = 1.0;
+    record.m_inputs          = 1;
+    record.m_cache_hit       = false;
+    record.m_fitness         = BOGUS_RUN_TIME;
+    return record;
+}
+
+// test a compiled program, and send the details to the listener
+static double test_compiled(evaluation_record & record,
+                            const string & temp_name,
+                            const benchmark_suite & suite,
+                            size_t input,
+                            acovea_listener & listener,
+                            optimization_mode mode,
+                            const fitness_formula & formula,
+                            fitness_cache * cache,
+                            double * code_size,
+                            double scale)
+{
+    // resulting fitness
+    double fitness = 0.0;
+    
+    if (code_size != NULL)
+        *code_size = BOGUS_RUN_TIME;
+    
+    // fingerprint of the compiled program, if it is being cached
+    uint64_t fingerprint = 0;
+    const string & command_text = record.m_command;
+
+    // make sure compile succeeded before running program
+    if (record.m_compiled)
+    {
+        ACOVEA_TIME_PHASE(io_timer,PHASE_FILE_IO);
+
+        // the size of the program is wanted along with its fitness
+        if (code_size != NULL)
+        {
+            struct stat stats;
+            stat(temp_name.c_str(),&stats);
+            *code_size = (double)stats.st_size;
+        }
+
+        ACOVEA_STOP_PHASE(io_timer);
+
+        // binary size is cheap to measure, so only cache benchmark runs
+        bool cached = false;
+
+        if ((cache != NULL) && (mode != OPTIMIZE_SIZE))
+        {
+            ACOVEA_TIME_PHASE(cache_timer,PHASE_CACHE);
+            fingerprint = cache->fingerprint(temp_name);
+
+            // a scaled workload is a different measurement of the same binary
+            if ((fingerprint != 0) && (scale != 1.0))
+                fingerprint = fnv1a(fingerprint,reinterpret_cast<const unsigned char *>(&scale),sizeof(scale));
+
+            cached = (fingerprint != 0) && cache->lookup(fingerprint,fitness);
+        }
+
+        if (cached)
+        {
+            // an identical program has already been measured
+            record.m_cache_hit = true;
+        }
+        else if (mode == OPTIMIZE_SIZE)
+        {
+            // get resulting file size and use as fitness
+            struct stat stats;
+            stat(temp_name.c_str(),&stats);
+            fitness = (double)stats.st_size;
+            record.m_samples.push_back(fitness);
+        }
+        else // OPTIMIZE_SPEED, OPTIMIZE_RETVAL or OPTIMIZE_PARETO
+        {
+            benchmark_result result;
+            benchmark_runner runner(temp_name,listener,false,scale);
+            double start = wall_seconds();
+            fitness = run_program(temp_name,command_text,listener,mode,formula,&record.m_exit_status,&result,&runner);
+            record.m_run_seconds.push_back(wall_seconds() - start);
+            record.m_metrics = result.get_fields();
+
+            // a faster wrong answer is a failure; a scaled workload has
+            //   a different answer
+            if ((fitness != BOGUS_RUN_TIME) && (scale == 1.0) && !verify_result(suite,input,record.m_metrics,command_text,listener))
+                fitness = BOGUS_RUN_TIME;
+
+            record.m_samples.push_back(fitness);
+
+            // remember this measurement for identical programs
+            if (fingerprint != 0)
+                cache->record(fingerprint,fitness);
+        }
+    }
+    else
+        fitness = BOGUS_RUN_TIME;
+    
+    // remove temporary file
+    {
+        ACOVEA_TIME_PHASE(remove_timer,PHASE_FILE_IO);
+        remove(temp_name.c_str());
+    }
+
+    record.m_fitness = fitness;
+    listener.report_evaluation(record);
+
+    // done
+    return fitness;
+}
+
+static string get_temp_name()
+{
+    ACOVEA_TIME_PHASE(io_timer,PHASE_FILE_IO);
+
+    // generate a unique file name
+    uint32_t file_code = 0;     
+    
+    // first try to read /dev/urandom
+    int fd = open ("/dev/urandom", O_RDONLY);
+
+    if (fd != -1)
+    {
+        read(fd, &file_code, 4);
+        close(fd);
+    }
+    else
+        file_code = (uint32_t)time(NULL);
+    
+    char temp_name[32];
+    snprintf(temp_name,32,"/tmp/ACOVEA%08X",file_code);
+    return string(temp_name);    
+}
+        
+//----------------------------------------------------------
+// profile cache
+
+// remove a directory and everything in it
+static int remove_entry(const char * a_path, const struct stat * a_stat, int a_flag, struct FTW * a_ftw)
+{
+    return remove(a_path);
+}
+
+static void remove_tree(const string & a_path)
+{
+    nftw(a_path.c_str(),remove_entry,16,FTW_DEPTH | FTW_PHYS);
+}
+
+// creation constructor
+profile_cache::profile_cache(const application & a_target, acovea_listener & a_listener)
+  : m_target(a_target),
+    m_listener(a_listener),
+    m_profiles(),
+    m_trained(0),
+    m_reused(0),
+    m_gen_trained(0),
+    m_gen_reused(0),
+    m_owner(getpid())
+{
+    // nada
+}
+
+// destructor; removes the profiles
+profile_cache::~profile_cache()
+{
+    if (getpid() != m_owner)
+        return;
+
+    for (map<string,string>::const_iterator profile = m_profiles.begin(); profile != m_profiles.end(); ++profile)
+    {
+        if (!profile->second.empty())
+            remove_tree(profile->second);
+    }
+}
+
+// directory holding the profile for an input and option set
+string profile_cache::get_profile(const string & a_input_name, const chromosome & a_options)
+{
+    string key = a_input_name + "\n" + m_target.get_profile_key(a_options);
+    map<string,string>::const_iterator profile = m_profiles.find(key);
+
+    if (profile != m_profiles.end())
+    {
+        ++m_reused;
+        ++m_gen_reused;
+        return profile->second;
+    }
+
+    // a profile that can't be trained isn't tried again
+    string profile_dir = train(a_input_name,a_options);
+    m_profiles[key] = profile_dir;
+
+    ++m_trained;
+    ++m_gen_trained;
+
+    return profile_dir;
+}
+
+// build and run an instrumented program in a new directory
+string profile_cache::train(const string & a_input_name, const chromosome & a_options)
+{
+    char dir_name[] = "/tmp/ACOVEAPROFILEXXXXXX";
+
+    if (mkdtemp(dir_name) == NULL)
+    {
+        m_listener.report_error("\nUNABLE TO CREATE PROFILE DIRECTORY\n");
+        return string();
+    }
+
+    string profile_dir(dir_name);
+    string temp_name = get_temp_name();
+    string command_text;
+
+    bool trained = compile_program(m_target.get_profile_command(a_input_name,temp_name,a_options,profile_dir),
+                                   m_listener,command_text);
+
+    if (trained)
+    {
+        ACOVEA_TIME_PHASE(run_timer,PHASE_RUN);
+
+        string output;
+        int status;
+        benchmark_runner runner(temp_name,m_listener,false,m_target.get_profile_scale());
+        runner.run(output,status);
+
+        if (status != 0)
+        {
+            ostringstream errormsg;
+            errormsg << "\nTRAINING RUN FAILED:\n" << command_text << endl;
+            m_listener.report_error(errormsg.str());
+            trained = false;
+        }
+    }
+
+    remove(temp_name.c_str());
+
+    if (!trained)
+    {
+        remove_tree(profile_dir);
+        return string();
+    }
+
+    return profile_dir;
+}
+
+// text describing the cache for configuration reports
+string profile_cache::get_description() const
+{
+    ostringstream result;
+    result << "trained per input and " << m_target.get_profile_option_count()
+           << " instrumentation option(s), at workload scale " << m_target.get_profile_scale();
+    return result.str();
+}
+
+// profiles trained and reused in the current generation
+string profile_cache::get_stats_text() const
+{
+    ostringstream result;
+    result << "profile cache: " << m_gen_trained << " trained, " << m_gen_reused << " reused; run total "
+           << m_trained << " trained, " << m_reused << " reused\n";
+    return result.str();
+}
+
+// begin counting a new generation
+void profile_cache::reset_generation_stats()
+{
+    m_gen_trained = 0;
+    m_gen_reused  = 0;
+}
+
+// source compiled for an input: with separately tuned functions, a file
+//   beside the program holding the input with their options in pragmas.
+//   Returns empty if that can't be written.
+static string function_source_file(const application & target,
+                                   const string & input_name,
+                                   const string & temp_name,
+                                   const chromosome & options,
+                                   acovea_listener & listener)
+{
+    bool tuned = false;
+
+    for (size_t f = 0; f < target.get_functions().size(); ++f)
+        tuned = tuned || !target.get_function_flags(options,f).empty();
+
+    if (!tuned)
+        return input_name;
+
+    ACOVEA_TIME_PHASE(io_timer,PHASE_FILE_IO);
+
+    // keep the input's extension, which tells the compiler its language
+    size_t dot   = input_name.rfind('.');
+    size_t slash = input_name.rfind('/');
+    string source_name = temp_name + (((dot != string::npos) && ((slash == string::npos) || (dot > slash))) ? input_name.substr(dot) : string(".c"));
+
+    string source = target.get_function_source(input_name,options);
+    ofstream file(source_name.c_str());
+
+    if (source.empty() || !(file << source))
+    {
+        listener.report_error("\nUNABLE TO WRITE TUNED SOURCE FOR " + input_name + "\n");
+        return string();
+    }
+
+    return source_name;
+}
+
+// command for compiling an input, from a baseline or, if that is NULL,
+//   from the configuration's prime command
+static vector<string> suite_command(const application & target,
+                                    const command_elements * baseline,
+                                    const string & input_name,
+                                    const string & temp_name,
+                                    const chromosome & options,
+                                    const string & profile_dir)
+{
+    if (baseline != NULL)
+        return target.get_command(*baseline,input_name,temp_name,options,profile_dir);
+    else
+        return target.get_prime_command(input_name,temp_name,options,profile_dir);
+}
+
+// compile and test an option set on every input of a suite, returning
+//   the combined fitness; the inputs are compiled at once, then run one
+//   at a time so that they don't disturb each other's timing
+static double run_suite(const benchmark_suite & suite,
+                        const application & target,
+                        const command_elements * baseline,
+                        const chromosome & options,
+                        acovea_listener & listener,
+                        optimization_mode mode,
+                        fitness_cache * cache = NULL,
+                        profile_cache * profiles = NULL,
+                        double * code_size = NULL,
+                        double scale = 1.0,
+                        vector<evaluation_record> * input_records = NULL)
+{
+    size_t inputs = suite.size();
+    vector<double>            fitness(inputs,BOGUS_RUN_TIME);
+    vector<string>            temp_names(inputs);
+    vector<evaluation_record> records(inputs,new_record(options));
+    vector<pid_t>             pids(inputs);
+    vector<string>            source_names(inputs);
+    double start = wall_seconds();
+
+    {
+        ACOVEA_TIME_PHASE(compile_timer,PHASE_COMPILE);
+
+        for (size_t n = 0; n < inputs; ++n)
+        {
+            temp_names[n] = get_temp_name();
+            records[n].m_scale = scale;
+
+            // a two-phase build needs a trained profile first; baselines
+            //   are ordinary builds
+            string profile_dir;
+
+            if ((profiles != NULL) && (baseline == NULL))
+            {
+                profile_dir = profiles->get_profile(suite.get_input(n),options);
+
+                if (profile_dir.empty())
+                {
+                    pids[n] = -1;
+                    continue;
+                }
+            }
+
+            // separately tuned functions are compiled from generated source
+            source_names[n] = suite.get_input(n);
+
+            if (baseline == NULL)
+            {
+                source_names[n] = function_source_file(target,suite.get_input(n),temp_names[n],options,listener);
+
+                if (source_names[n].empty())
+                {
+                    pids[n] = -1;
+                    continue;
+                }
+            }
+
+            pids[n] = start_compile(suite_command(target,baseline,source_names[n],temp_names[n],options,profile_dir),
+                                    records[n].m_command);
+        }
+
+        for (size_t n = 0; n < inputs; ++n)
+        {
+            if (pids[n] > 0)
+                records[n].m_compiled    = finish_compile(pids[n],records[n].m_command,listener,&records[n].m_exit_status);
+
+            if (!source_names[n].empty() && (source_names[n] != suite.get_input(n)))
+                remove(source_names[n].c_str());
+
+            records[n].m_compile_seconds = wall_seconds() - start;
+        }
+    }
+
+    // code size is the total for all inputs
+    if (code_size != NULL)
+        *code_size = 0.0;
+
+    for (size_t n = 0; n < inputs; ++n)
+    {
+        double size = 0.0;
+        fitness[n] = test_compiled(records[n],temp_names[n],suite,n,listener,mode,target.get_fitness(),cache,
+                                   (code_size != NULL) ? &size : NULL,scale);
+
+        if ((code_size != NULL) && (*code_size != BOGUS_RUN_TIME))
+            *code_size = (size == BOGUS_RUN_TIME) ? BOGUS_RUN_TIME : (*code_size + size);
+    }
+
+    if (input_records != NULL)
+        *input_records = records;
+
+    return suite.combine(fitness);
+}
+
+double acovea_landscape::test(acovea_organism & a_org, bool a_verbose) const
+{
+    return test_scaled(a_org,1.0);
+}
+
+// test an option list with a scaled workload
+double acovea_landscape::test_scaled(acovea_organism & a_org, double a_scale) const
+{
+    // label the spans of this test on the trace
+    trace_writer & trace = trace_writer::global();
+
+    if (trace.is_open())
+        trace.begin_test(a_org.genes());
+
+    ACOVEA_TIME_PHASE(test_timer,PHASE_TEST);
+
+    // cache hits are not new information for the surrogate model
+    size_t cache_hits = (m_cache != NULL) ? m_cache->hits() : 0;
+    
+    // run a test
+    a_org.fitness() = run_suite(*m_suite,
+                                m_target,
+                                NULL,
+                                a_org.genes(),
+                                m_events,
+                                m_mode,
+                                m_cache,
+                                m_profiles,
+                                (m_mode == OPTIMIZE_PARETO) ? &a_org.code_size() : NULL,
+                                a_scale);
+
+    // until the population is ranked, fitness is just the run time
+    if (m_mode == OPTIMIZE_PARETO)
+        a_org.run_time() = a_org.fitness();
+
+    // learn from the new measurement, if it is of the full workload
+    if ((m_surrogate != NULL) && (a_scale == 1.0) && ((m_cache == NULL) || (m_cache->hits() == cache_hits)))
+        m_surrogate->train(a_org.genes(),a_org.fitness());
+
+    ACOVEA_STOP_PHASE(test_timer);
+    trace.end_test();
+
+    // done
+    return a_org.fitness();
+}
+
+// fitness testing
+double acovea_landscape::test(vector< acovea_organism > & a_population) const
+{
+    double result = 0.0;
+    size_t n = 0;
+
+    // organisms restored from a checkpoint keep their saved fitness
+    if ((m_checkpoint != NULL) && m_checkpoint->is_replaying())
+    {
+        for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
+            result += org->fitness();
+
+        return result / a_population.size();
+    }
+
+    // screen with smaller workloads first
+    if (m_fidelity != NULL)
+        return test_rungs(a_population);
+
+    // test each org
+    for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
+    {
+        ++n;
+        m_listener.ping_fitness_test_begin(n);
+        result += test(*org);
+        m_listener.ping_fitness_test_end(n);
+        m_listener.yield();
+    }
+
+    // rank the population by its trade-offs between speed and size
+    if (m_mode == OPTIMIZE_PARETO)
+    {
+        assign_pareto_fitness(a_population);
+
+        result = 0.0;
+
+        for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
+            result += org->fitness();
+    }
+
+    // done; return average population fitness
+    return result / a_population.size();
+}
+
+// ordering of organisms by fitness, through their indices
+struct fitness_order
+{
+    const vector<double> & m_fitness;
+
+    fitness_order(const vector<double> & a_fitness)
+      : m_fitness(a_fitness)
+    {
+        // nada
+    }
+
+    bool operator () (size_t a_left, size_t a_right) const
+    {
+        return m_fitness[a_left] < m_fitness[a_right];
+    }
+};
+
+// test a population through the rungs of the fidelity schedule
+double acovea_landscape::test_rungs(vector< acovea_organism > & a_population) const
+{
+    const vector<double> & scales = m_fidelity->get_scales();
+
+    // organisms still being tested, and the rung each one reached
+    vector<size_t> entrants;
+    vector<size_t> reached(a_population.size(),0);
+    vector<double> fitness(a_population.size(),BOGUS_RUN_TIME);
+
+    // fitness of the last organism promoted from each rung
+    vector<double> cutoffs(scales.size(),BOGUS_RUN_TIME);
+
+    for (size_t i = 0; i < a_population.size(); ++i)
+        entrants.push_back(i);
+
+    size_t n = 0;
+
+    for (size_t rung = 0; rung < scales.size(); ++rung)
+    {
+        for (vector<size_t>::iterator i = entrants.begin(); i != entrants.end(); ++i)
+        {
+            ++n;
+            m_listener.ping_fitness_test_begin(n);
+            fitness[*i] = test_scaled(a_population[*i],scales[rung]);
+            reached[*i] = rung;
+            m_listener.ping_fitness_test_end(n);
+            m_listener.yield();
+        }
+
+        m_fidelity->count(rung,entrants.size());
+
+        if (rung + 1 == scales.size())
+            break;
+
+        // the best move on; failures never do
+        stable_sort(entrants.begin(),entrants.end(),fitness_order(fitness));
+
+        size_t promoted = m_fidelity->promoted(entrants.size());
+
+        while ((promoted > 0) && (fitness[entrants[promoted - 1]] == BOGUS_RUN_TIME))
+            --promoted;
+
+        entrants.resize(promoted);
+
+        if (promoted > 0)
+            cutoffs[rung] = fitness[entrants[promoted - 1]];
+    }
+
+    // organisms that stopped at a smaller workload rank behind every one
+    //   that went further, in the order of their own screening
+    double worst = 0.0;
+
+    for (size_t i = 0; i < a_population.size(); ++i)
+    {
+        if ((reached[i] + 1 == scales.size()) && (fitness[i] != BOGUS_RUN_TIME))
+            worst = max(worst,fitness[i]);
+    }
+
+    for (size_t rung = scales.size() - 1; rung-- > 0; )
+    {
+        double rung_worst = worst;
+
+        for (size_t i = 0; i < a_population.size(); ++i)
+        {
+            if ((reached[i] != rung) || (fitness[i] == BOGUS_RUN_TIME))
+                continue;
+
+            // with nothing to compare against, extrapolate to full scale
+            if ((worst > 0.0) && (cutoffs[rung] > 0.0) && (cutoffs[rung] != BOGUS_RUN_TIME))
+                a_population[i].fitness() = worst * fitness[i] / cutoffs[rung];
+            else
+                a_population[i].fitness() = fitness[i] / scales[rung];
+
+            rung_worst = max(rung_worst,a_population[i].fitness());
+        }
+
+        worst = rung_worst;
+    }
+
+    // done; return average population fitness
+    double result = 0.0;
+
+    for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
+        result += org->fitness();
+
+    return result / a_population.size();
+}
+
+// comparison of organism indices by one objective, for crowding distance
+class objective_order
+{
+    public:
+        objective_order(const vector< acovea_organism > & a_population, bool a_by_size)
+          : m_population(a_population),
+            m_by_size(a_by_size)
+        {
+            // nada
+        }
+
+        bool operator () (size_t a_left, size_t a_right) const
+        {
+            if (m_by_size)
+                return m_population[a_left].code_size() < m_population[a_right].code_size();
+            else
+                return m_population[a_left].run_time() < m_population[a_right].run_time();
+        }
+
+    private:
+        const vector< acovea_organism > & m_population;
+        bool m_by_size;
+};
+
+// assign fitness from Pareto rank and crowding distance (NSGA-II); fitness
+//   becomes rank + 0.5 / (1 + crowding), so that lower is better, every
+//   member of a front beats every member of the next front, and the less
+//   crowded of two organisms in the same front is preferred
+void acovea_landscape::assign_pareto_fitness(vector< acovea_organism > & a_population)
+{
+    size_t size = a_population.size();
+
+    // failed organisms do not participate in ranking
+    vector<size_t> remaining;
+
+    for (size_t n = 0; n < size; ++n)
+    {
+        if ((a_population[n].run_time() == BOGUS_RUN_TIME) || (a_population[n].code_size() == BOGUS_RUN_TIME))
+            a_population[n].fitness() = BOGUS_RUN_TIME;
+        else
+            remaining.push_back(n);
+    }
+
+    // peel off successive non-dominated fronts
+    size_t rank = 1;
+
+    while (!remaining.empty())
+    {
+        vector<size_t> front;
+        vector<size_t> dominated;
+
+        for (size_t i = 0; i < remaining.size(); ++i)
+        {
+            bool is_dominated = false;
+
+            for (size_t j = 0; (j < remaining.size()) && !is_dominated; ++j)
+            {
+                if (a_population[remaining[j]].dominates(a_population[remaining[i]]))
+                    is_dominated = true;
+            }
+
+            if (is_dominated)
+                dominated.push_back(remaining[i]);
+            else
+                front.push_back(remaining[i]);
+        }
+
+        // crowding distance, normalized per objective
+        vector<double> crowding(size,0.0);
+
+        for (int objective = 0; objective < 2; ++objective)
+        {
+            bool by_size = (objective == 1);
+            sort(front.begin(),front.end(),objective_order(a_population,by_size));
+
+            double low  = by_size ? a_population[front.front()].code_size() : a_population[front.front()].run_time();
+            double high = by_size ? a_population[front.back()].code_size()  : a_population[front.back()].run_time();
+
+            crowding[front.front()] = numeric_limits<double>::infinity();
+            crowding[front.back()]  = numeric_limits<double>::infinity();
+
+            if (high <= low)
+                continue;
+
+            for (size_t i = 1; i + 1 < front.size(); ++i)
+            {
+                double prev = by_size ? a_population[front[i - 1]].code_size() : a_population[front[i - 1]].run_time();
+                double next = by_size ? a_population[front[i + 1]].code_size() : a_population[front[i + 1]].run_time();
+                crowding[front[i]] += (next - prev) / (high - low);
+            }
+        }
+
+        for (size_t i = 0; i < front.size(); ++i)
+            a_population[front[i]].fitness() = static_cast<double>(rank) + 0.5 / (1.0 + crowding[front[i]]);
+
+        remaining = dominated;
+        ++rank;
+    }
+}
+
+//----------------------------------------------------------
+// population seeder
+
+// creation constructor
+population_seeder::population_seeder(const application & a_target, double a_fraction, double a_mutation)
+  : m_target(a_target),
+    m_fraction(a_fraction),
+    m_mutation(a_mutation),
+    m_seeds(),
+    m_seed_flags(),
+    m_next(0),
+    m_matched(0),
+    m_flags(0),
+    m_repeats(0),
+    m_unmatched()
+{
+    if (m_fraction < 0.0)
+        m_fraction = 0.0;
+    else if (m_fraction > 1.0)
+        m_fraction = 1.0;
+}
+
+// add a seed unless an identical one is already there
+void population_seeder::add_seed(const chromosome & a_options)
+{
+    if (m_seed_flags.insert(get_flags(a_options)).second)
+        m_seeds.push_back(a_options);
+    else
+        ++m_repeats;
+}
+
+// add the baselines as seeds; a baseline that sets none of the options
+//   (like -O2 alone) would only seed the all-disabled option set
+void population_seeder::add_baselines()
+{
+    vector<command_elements> baselines = m_target.get_baselines();
+
+    for (int n = 0; n < baselines.size(); ++n)
+    {
+        chromosome options = m_target.get_options();
+
+        if (map_flags(baselines[n].m_flags,options) == 0)
+            m_unmatched.push_back(baselines[n].m_description);
+        else
+            add_seed(options);
+    }
+}
+
+// ordering of seeds by fitness
+struct seed_order
+{
+    bool operator () (const pair<double, size_t> & a_left, const pair<double, size_t> & a_right) const
+    {
+        return a_left.first < a_right.first;
+    }
+};
+
+// add seeds from a file, best first
+void population_seeder::add_file(const string & a_file_name)
+{
+    ifstream file(a_file_name.c_str());
+
+    if (!file)
+        throw runtime_error("unable to open seed file " + a_file_name);
+
+    vector< pair<double, size_t> > order;
+    vector<string> lines;
+    string line;
+
+    while (getline(file,line))
+    {
+        string::size_type start = line.find_first_not_of(" \t\r");
+
+        // skip blank lines and comments
+        if ((start == string::npos) || (line[start] == '#'))
+            continue;
+
+        // an optional leading fitness orders the seeds; lines without one keep their place, last
+        double fitness = numeric_limits<double>::infinity();
+        const char * text = line.c_str() + start;
+        char * end;
+        double value = strtod(text,&end);
+
+        if ((end != text) && ((*end == ' ') || (*end == '\t') || (*end == '\0')))
+        {
+            fitness = value;
+            line = string(end);
+        }
+
+        order.push_back(make_pair(fitness,lines.size()));
+        lines.push_back(line);
+    }
+
+    stable_sort(order.begin(),order.end(),seed_order());
+
+    for (size_t n = 0; n < order.size(); ++n)
+    {
+        chromosome options = m_target.get_options();
+        map_flags(lines[order[n].second],options);
+        add_seed(options);
+    }
+}
+
+// set options matching a list of command-line flags
+size_t population_seeder::map_flags(const string & a_flags, chromosome & a_options)
+{
+    for (int n = 0; n < a_options.size(); ++n)
+        a_options[n]->set_enabled(false);
+
+    istringstream flags(a_flags);
+    string flag;
+    size_t matched = 0;
+    size_t seen    = 0;
+
+    while (flags >> flag)
+    {
+        // baselines name their input and output with placeholders
+        if (flag.find("ACOVEA_") != string::npos)
+            continue;
+
+        ++seen;
+
+        for (int n = 0; n < a_options.size(); ++n)
+        {
+            tuning_option * tuning = dynamic_cast<tuning_option *>(a_options[n]);
+
+            if (tuning != NULL)
+            {
+                // name, separator, value
+                string prefix = tuning->get_choices()[0] + tuning->get_separator();
+
+                if (flag.compare(0,prefix.size(),prefix) == 0)
+                {
+                    tuning->set_enabled(true);
+                    tuning->set_value(atoi(flag.c_str() + prefix.size()));
+                    ++matched;
+                    break;
+                }
+            }
+            else
+            {
+                vector<string> choices = a_options[n]->get_choices();
+                vector<string>::iterator choice = find(choices.begin(),choices.end(),flag);
+
+                if (choice != choices.end())
+                {
+                    a_options[n]->set_enabled(true);
+
+                    enum_option * choice_option = dynamic_cast<enum_option *>(a_options[n]);
+
+                    if (choice_option != NULL)
+                        choice_option->set_setting(choice - choices.begin());
+
+                    ++matched;
+                    break;
+                }
+            }
+        }
+    }
+
+    // tally for the configuration report
+    m_matched += matched;
+    m_flags   += seen;
+
+    return matched;
+}
+
+// the flags for a list of options
+string population_seeder::get_flags(const chromosome & a_options)
+{
+    string result;
+
+    for (int n = 0; n < a_options.size(); ++n)
+    {
+        if (a_options[n]->is_enabled())
+        {
+            if (!result.empty())
+                result += " ";
+
+            result += a_options[n]->get();
+        }
+    }
+
+    return result;
+}
+
+// write populations to a file, best first, without repeats
+void population_seeder::save(const string & a_file_name,
+                             const vector< vector<acovea_organism> > & a_populations)
+{
+    vector< pair<double, string> > entries;
+
+    for (size_t p = 0; p < a_populations.size(); ++p)
+    {
+        for (vector<acovea_organism>::const_iterator org = a_populations[p].begin(); org != a_populations[p].end(); ++org)
+        {
+            if (org->fitness() != BOGUS_RUN_TIME)
+                entries.push_back(make_pair(org->fitness(),get_flags(org->genes())));
+        }
+    }
+
+    sort(entries.begin(),entries.end());
+
+    ofstream file(a_file_name.c_str());
+
+    if (!file)
+        throw runtime_error("unable to write seed file " + a_file_name);
+
+    file << "# ACOVEA seeds: fitness, then options\n";
+
+    // an option set measured more than once is written with its best fitness
+    set<string> written;
+
+    for (size_t n = 0; n < entries.size(); ++n)
+    {
+        if (!written.insert(entries[n].second).second)
+            continue;
+
+        file << setprecision(10) << entries[n].first << " " << entries[n].second << "\n";
+    }
+}
+
+// start a population with seeds
+size_t population_seeder::seed(vector<acovea_organism> & a_population, size_t a_size)
+{
+    if (m_seeds.empty())
+        return 0;
+
+    size_t count = size_t(a_size * m_fraction + 0.5);
+
+    if (count > a_size)
+        count = a_size;
+
+    for (size_t n = 0; n < count; ++n, ++m_next)
+    {
+        acovea_organism org(m_target,m_seeds[m_next % m_seeds.size()]);
+
+        // the first use of each seed is exact; later ones are varied
+        if (m_next >= m_seeds.size())
+            m_target.mutate(org.genes(),m_mutation);
+
+        a_population.push_back(org);
+    }
+
+    return count;
+}
+
+// description for configuration reports
+string population_seeder::get_description() const
+{
+    ostringstream result;
+
+    if (m_seeds.empty())
+        result << "none";
+    else
+        result << m_seeds.size() << " (" << m_matched << " of " << m_flags << " flags matched options), "
+               << (m_fraction * 100.0) << "% of each population, mutation " << m_mutation;
+
+    if (m_repeats > 0)
+        result << "; " << m_repeats << " repeated seed(s) dropped";
+
+    for (size_t n = 0; n < m_unmatched.size(); ++n)
+        result << ((n == 0) ? "; baselines matching no options skipped: " : ", ") << m_unmatched[n];
+
+    return result.str();
+}
+
+//----------------------------------------------------------
+// run budget
+
+// creation constructor
+run_budget::run_budget(const run_settings & a_settings)
+  : m_max_evaluations(a_settings.m_max_evaluations),
+    m_max_minutes(a_settings.m_max_minutes),
+    m_target_ratio(a_settings.m_target_ratio),
+    m_stall_generations(a_settings.m_stall_generations),
+    m_stall_epsilon(a_settings.m_stall_epsilon),
+    m_reserve(a_settings.m_budget_reserve),
+    m_start_time(wall_seconds()),
+    m_baseline(0.0),
+    m_best(BOGUS_RUN_TIME),
+    m_stalled(0)
+{
+    if ((m_reserve < 0.0) || (m_reserve >= 1.0))
+        throw runtime_error("budget reserve must be at least 0 and less than 1");
+}
+
+// is any limit set?
+bool run_budget::is_limited() const
+{
+    return (m_max_evaluations > 0) || (m_max_minutes > 0.0) || (m_target_ratio > 0.0) || (m_stall_generations > 0);
+}
+
+// set the fitness that the target is relative to
+void run_budget::set_baseline(double a_fitness)
+{
+    m_baseline = a_fitness;
+}
+
+// may a_count more tests be started, after a_evaluations tests?
+bool run_budget::allows(double a_evaluations, size_t a_count, string & a_reason) const
+{
+    double share = 1.0 - m_reserve;
+
+    if ((m_max_evaluations > 0)
+    &&  (a_evaluations + static_cast<double>(a_count) > share * static_cast<double>(m_max_evaluations)))
+    {
+        a_reason = "test limit reached";
+        return false;
+    }
+
+    if ((m_max_minutes > 0.0) && (a_evaluations > 0.0))
+    {
+        // assume coming tests take as long as past ones
+        double elapsed = wall_seconds() - m_start_time;
+        double needed  = elapsed / a_evaluations * static_cast<double>(a_count);
+
+        if (elapsed + needed > share * m_max_minutes * 60.0)
+        {
+            a_reason = "time limit reached";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// note the best fitness after a generation
+bool run_budget::is_finished(double a_best_fitness, string & a_reason)
+{
+    if ((m_target_ratio > 0.0) && (m_baseline != BOGUS_RUN_TIME) && (a_best_fitness <= m_target_ratio * m_baseline))
+    {
+        a_reason = "target fitness reached";
+        return true;
+    }
+
+    if (m_stall_generations > 0)
+    {
+        if ((m_best == BOGUS_RUN_TIME) || (a_best_fitness < m_best - m_stall_epsilon * fabs(m_best)))
+        {
+            m_best    = a_best_fitness;
+            m_stalled = 0;
+        }
+        else if (++m_stalled >= m_stall_generations)
+        {
+            ostringstream reason;
+            reason << "no improvement for " << m_stalled << " generations";
+            a_reason = reason.str();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// description for configuration reports
+string run_budget::get_description() const
+{
+    if (!is_limited())
+        return string("unlimited");
+
+    ostringstream text;
+    const char * separator = "";
+
+    if (m_max_evaluations > 0)
+    {
+        text << separator << m_max_evaluations << " tests";
+        separator = ", ";
+    }
+
+    if (m_max_minutes > 0.0)
+    {
+        text << separator << m_max_minutes << " minutes";
+        separator = ", ";
+    }
+
+    if (m_target_ratio > 0.0)
+    {
+        text << separator << "target " << m_target_ratio << " of best baseline";
+        separator = ", ";
+    }
+
+    if (m_stall_generations > 0)
+        text << separator << "stop after " << m_stall_generations << " generations within " << (m_stall_epsilon * 100.0) << "%";
+
+    if ((m_max_evaluations > 0) || (m_max_minutes > 0.0))
+        text << " (" << (m_reserve * 100.0) << "% reserved for final report)";
+
+    return text.str();
+}
+
+//----------------------------------------------------------
+// parallel tester
+
+// creation constructor
+parallel_tester::parallel_tester(const benchmark_suite & a_suite,
+                                 optimization_mode   a_mode,
+                                 const application & a_target,
+                                 acovea_listener &   a_listener,
+                                 size_t              a_jobs,
+                                 size_t              a_repeats,
+                                 bool                a_fork_server)
+  : m_suite(a_suite),
+    m_mode(a_mode),
+    m_target(a_target),
+    m_listener(a_listener),
+    m_jobs(a_jobs),
+    m_repeats(a_repeats),
+    m_fork_server(a_fork_server),
+    m_profiles(NULL),
+    m_pids(),
+    m_pipes(),
+    m_tags(),
+    m_started(),
+    m_slots(),
+    m_tests()
+{
+    if (m_jobs < 1)
+        m_jobs = 1;
+
+    if (m_repeats < 1)
+        m_repeats = 1;
+}
+
+// compile and run one option set on one input
+vector<double> parallel_tester::sample_input(size_t a_input,
+                                             const chromosome & a_options,
+                                             evaluation_record & a_record) const
+{
+    vector<double> samples;
+
+    string temp_name = get_temp_name();
+    string command_text;
+    double start = wall_seconds();
+
+    a_record = new_record(a_options);
+
+    // a two-phase build uses the profile trained before this process started
+    string profile_dir;
+
+    if (m_profiles != NULL)
+    {
+        profile_dir = m_profiles->get_profile(m_suite.get_input(a_input),a_options);
+
+        if (profile_dir.empty())
+        {
+            samples.push_back(BOGUS_RUN_TIME);
+            return samples;
+        }
+    }
+
+    // separately tuned functions are compiled from generated source
+    string source_name = function_source_file(m_target,m_suite.get_input(a_input),temp_name,a_options,m_listener);
+
+    if (source_name.empty())
+    {
+        samples.push_back(BOGUS_RUN_TIME);
+        return samples;
+    }
+
+    a_record.m_compiled        = compile_program(m_target.get_prime_command(source_name,temp_name,a_options,profile_dir),
+                                                 m_listener,command_text,&a_record.m_exit_status);
+
+    if (source_name != m_suite.get_input(a_input))
+        remove(source_name.c_str());
+
+    a_record.m_compile_seconds = wall_seconds() - start;
+    a_record.m_command         = command_text;
+
+    if (a_record.m_compiled)
+    {
+        if (m_mode == OPTIMIZE_SIZE)
+        {
+            // size doesn't vary from run to run
+            struct stat stats;
+            stat(temp_name.c_str(),&stats);
+            samples.push_back((double)stats.st_size);
+        }
+        else
+        {
+            // a fork server saves starting the program for every run
+            benchmark_runner runner(temp_name,m_listener,m_fork_server && (m_repeats > 1));
+
+            for (size_t n = 0; n < m_repeats; ++n)
+            {
+                start = wall_seconds();
+                benchmark_result result;
+                samples.push_back(run_program(temp_name,command_text,m_listener,m_mode,m_target.get_fitness(),
+                                              &a_record.m_exit_status,&result,&runner));
+                a_record.m_run_seconds.push_back(wall_seconds() - start);
+                a_record.m_metrics = result.get_fields();
+
+                if ((samples.back() != BOGUS_RUN_TIME) && !verify_result(m_suite,a_input,a_record.m_metrics,command_text,m_listener))
+                    samples.back() = BOGUS_RUN_TIME;
+
+                // no point in repeating a failure
+                if (samples.back() == BOGUS_RUN_TIME)
+                    break;
+            }
+        }
+
+        a_record.m_samples = samples;
+    }
+    else
+        samples.push_back(BOGUS_RUN_TIME);
+
+    remove(temp_name.c_str());
+
+    return samples;
+}
+
+// compile and run one option set (in a child process)
+vector<double> parallel_tester::sample(const chromosome & a_options, evaluation_record & a_record) const
+{
+    if (!m_suite.is_combined())
+        return sample_input(0,a_options,a_record);
+
+    // each sample combines the corresponding runs on every input; the
+    //   record covers all of them, with metrics named by input
+    vector< vector<double> > input_samples(m_suite.size());
+    evaluation_record input_record;
+    size_t repeats = m_repeats;
+
+    a_record = new_record(a_options);
+    a_record.m_compiled = true;
+
+    for (size_t i = 0; i < m_suite.size(); ++i)
+    {
+        const string & input = m_suite.get_input(i);
+        input_samples[i] = sample_input(i,a_options,input_record);
+        repeats = min(repeats,input_samples[i].size());
+
+        a_record.m_command         += ((i > 0) ? "; " : "") + input_record.m_command;
+        a_record.m_compiled         = a_record.m_compiled && input_record.m_compiled;
+        a_record.m_compile_seconds += input_record.m_compile_seconds;
+        a_record.m_run_seconds.insert(a_record.m_run_seconds.end(),input_record.m_run_seconds.begin(),input_record.m_run_seconds.end());
+
+        if (input_record.m_exit_status != 0)
+            a_record.m_exit_status = input_record.m_exit_status;
+
+        for (map<string,string>::const_iterator field = input_record.m_metrics.begin(); field != input_record.m_metrics.end(); ++field)
+            a_record.m_metrics[input + "/" + field->first] = field->second;
+    }
+
+    vector<double> samples(repeats);
+    vector<double> fitness(m_suite.size());
+
+    for (size_t n = 0; n < repeats; ++n)
+    {
+        for (size_t i = 0; i < m_suite.size(); ++i)
+            fitness[i] = input_samples[i][n];
+
+        samples[n] = m_suite.combine(fitness);
+    }
+
+    // a failure on any input fails the option set
+    for (size_t i = 0; i < m_suite.size(); ++i)
+    {
+        if (find(input_samples[i].begin(),input_samples[i].end(),BOGUS_RUN_TIME) != input_samples[i].end())
+            samples.assign(1,BOGUS_RUN_TIME);
+    }
+
+    if (a_record.m_compiled)
+        a_record.m_samples = samples;
+
+    return samples;
+}
+
+// binary I/O of test records, from test processes to their parent
+static void write_text(FILE * a_file, const string & a_text)
+{
+    write_value<uint32_t>(a_file,a_text.size());
+
+    if (fwrite(a_text.data(),1,a_text.size(),a_file) != a_text.size())
+        throw runtime_error("unable to write text");
+}
+
+static string read_text(FILE * a_file)
+{
+    uint32_t length = read_value<uint32_t>(a_file);
+    string text(length,' ');
+
+    if ((length > 0) && (fread(&text[0],1,length,a_file) != length))
+        throw runtime_error("text is truncated");
+
+    return text;
+}
+
+static void write_doubles(FILE * a_file, const vector<double> & a_values)
+{
+    write_value<uint32_t>(a_file,a_values.size());
+
+    for (size_t n = 0; n < a_values.size(); ++n)
+        write_value<double>(a_file,a_values[n]);
+}
+
+static vector<double> read_doubles(FILE * a_file)
+{
+    vector<double> values(read_value<uint32_t>(a_file));
+
+    for (size_t n = 0; n < values.size(); ++n)
+        values[n] = read_value<double>(a_file);
+
+    return values;
+}
+
+// summarize a list of samples
+static measurement summarize(const vector<double> & a_samples)
+{
+    measurement result = { BOGUS_RUN_TIME, 0.0, a_samples.size() };
+
+    if (a_samples.empty() || (find(a_samples.begin(),a_samples.end(),BOGUS_RUN_TIME) != a_samples.end()))
+        return result;
+
+    double sum = 0.0;
+
+    for (size_t n = 0; n < a_samples.size(); ++n)
+        sum += a_samples[n];
+
+    result.m_mean = sum / a_samples.size();
+
+    if (a_samples.size() > 1)
+    {
+        double variance = 0.0;
+
+        for (size_t n = 0; n < a_samples.size(); ++n)
+            variance += (a_samples[n] - result.m_mean) * (a_samples[n] - result.m_mean);
+
+        result.m_deviation = sqrt(variance / (a_samples.size() - 1));
+    }
+
+    return result;
+}
+
+// start measuring an option set in the background
+bool parallel_tester::start(const chromosome & a_options, size_t a_tag) const
+{
+    if (m_pids.size() >= m_jobs)
+        return false;
+
+    // train profiles here, so that they are kept for later tests
+    if (m_profiles != NULL)
+    {
+        for (size_t i = 0; i < m_suite.size(); ++i)
+            m_profiles->get_profile(m_suite.get_input(i),a_options);
+    }
+
+    int fds[2];
+
+    if (pipe(fds) != 0)
+        throw runtime_error("unable to create pipe for test process");
+
+    // the first free slot, which is the test's lane on the trace
+    size_t slot = 0;
+
+    while (find(m_slots.begin(),m_slots.end(),slot) != m_slots.end())
+        ++slot;
+
+    trace_writer & trace = trace_writer::global();
+    size_t test = trace.is_open() ? trace.begin_test(a_options) : 0;
+
+    pid_t child_pid = fork();
+
+    if (child_pid < 0)
+        throw runtime_error("unable to fork test process");
+
+    if (child_pid == 0)
+    {
+        // child: test, send samples and details to parent, and vanish
+        close(fds[0]);
+
+        if (trace.is_open())
+            trace.begin_child();
+
+        evaluation_record record;
+        vector<double> samples = sample(a_options,record);
+        FILE * output = fdopen(fds[1],"w");
+
+        try
+        {
+            write_doubles(output,samples);
+            write_text(output,record.m_options);
+            write_text(output,record.m_command);
+            write_value<uint8_t>(output,record.m_compiled ? 1 : 0);
+            write_value<int32_t>(output,record.m_exit_status);
+            write_value<double>(output,record.m_compile_seconds);
+            write_doubles(output,record.m_run_seconds);
+            write_value<uint32_t>(output,record.m_metrics.size());
+
+            for (map<string,string>::const_iterator field = record.m_metrics.begin(); field != record.m_metrics.end(); ++field)
+            {
+                write_text(output,field->first);
+                write_text(output,field->second);
+            }
+
+            const vector<trace_span> & spans = trace.kept_spans();
+            write_value<uint32_t>(output,spans.size());
+
+            for (vector<trace_span>::const_iterator span = spans.begin(); span != spans.end(); ++span)
+            {
+                write_value<int32_t>(output,span->m_phase);
+                write_value<uint64_t>(output,span->m_start);
+                write_value<uint64_t>(output,span->m_end);
+                write_value<uint64_t>(output,span->m_test);
+                write_value<uint64_t>(output,span->m_genome);
+            }
+        }
+        catch (runtime_error &)
+        {
+            // the parent sees a truncated result, and a failed test
+        }
+
+        fclose(output);
+        _exit(0);
+    }
+
+    close(fds[1]);
+    trace.end_test();
+
+    m_pids.push_back(child_pid);
+    m_pipes.push_back(fds[0]);
+    m_tags.push_back(a_tag);
+    m_started.push_back(phase_profile::now());
+    m_slots.push_back(slot);
+    m_tests.push_back(test);
+
+    return true;
+}
+
+// collect a finished measurement, if there is one
+bool parallel_tester::collect(size_t & a_tag, measurement & a_result) const
+{
+    for (size_t i = 0; i < m_pids.size(); ++i)
+    {
+        int child_retval;
+
+        if (0 == waitpid(m_pids[i],&child_retval,WNOHANG))
+            continue;
+
+        vector<double> samples;
+        vector<trace_span> spans;
+        evaluation_record record = new_record(chromosome());
+        FILE * input = fdopen(m_pipes[i],"r");
+
+        try
+        {
+            samples = read_doubles(input);
+            record.m_options         = read_text(input);
+            record.m_command         = read_text(input);
+            record.m_compiled        = (read_value<uint8_t>(input) != 0);
+            record.m_exit_status     = read_value<int32_t>(input);
+            record.m_compile_seconds = read_value<double>(input);
+            record.m_run_seconds     = read_doubles(input);
+
+            uint32_t fields = read_value<uint32_t>(input);
+
+            for (uint32_t n = 0; n < fields; ++n)
+            {
+                string name = read_text(input);
+                record.m_metrics[name] = read_text(input);
+            }
+
+            uint32_t count = read_value<uint32_t>(input);
+
+            for (uint32_t n = 0; n < count; ++n)
+            {
+                trace_span span;
+                span.m_phase  = static_cast<run_phase>(read_value<int32_t>(input));
+                span.m_start  = read_value<uint64_t>(input);
+                span.m_end    = read_value<uint64_t>(input);
+                span.m_test   = static_cast<size_t>(read_value<uint64_t>(input));
+                span.m_genome = read_value<uint64_t>(input);
+                spans.push_back(span);
+            }
+        }
+        catch (runtime_error &)
+        {
+            if (samples.empty())
+                samples.assign(1,BOGUS_RUN_TIME);
+        }
+
+        fclose(input);
+
+        a_tag    = m_tags[i];
+        a_result = summarize(samples);
+
+        // a test process tries every input
+        record.m_samples = record.m_compiled ? samples : vector<double>();
+        record.m_inputs  = m_suite.size();
+        record.m_fitness = a_result.m_mean;
+        m_listener.report_evaluation(record);
+
+        // compiles and runs are timed in the test process, so only the
+        //   whole test is seen here
+#if !defined(ACOVEA_NO_TIMING)
+        uint64_t finished = phase_profile::now();
+        phase_profile::global().record(PHASE_TEST,finished - m_started[i]);
+
+        // lane zero is the main process
+        if (trace_writer::global().is_open())
+        {
+            trace_writer::global().add_test(m_tests[i],m_started[i],finished,m_slots[i] + 1);
+            trace_writer::global().add_spans(spans,m_slots[i] + 1);
+        }
+#endif
+
+        m_pids.erase(m_pids.begin() + i);
+        m_pipes.erase(m_pipes.begin() + i);
+        m_tags.erase(m_tags.begin() + i);
+        m_started.erase(m_started.begin() + i);
+        m_slots.erase(m_slots.begin() + i);
+        m_tests.erase(m_tests.begin() + i);
+
+        return true;
+    }
+
+    return false;
+}
+
+// measure a list of option sets
+vector<measurement> parallel_tester::measure(const vector<chromosome> & a_options) const
+{
+    vector<measurement> results(a_options.size());
+
+    size_t next = 0;
+    size_t done = 0;
+
+    while (done < a_options.size())
+    {
+        // start as many tests as allowed
+        while ((next < a_options.size()) && start(a_options[next],next))
+            ++next;
+
+        // collect finished tests
+        size_t tag;
+        measurement result;
+
+        if (collect(tag,result))
+        {
+            results[tag] = result;
+            ++done;
+        }
+        else
+            m_listener.yield();
+    }
+
+    return results;
+}
+
+// half-width of the 95% confidence interval of a mean
+double parallel_tester::confidence(const measurement & a_measurement)
+{
+    // two-tailed Student's t at 95%, by degrees of freedom
+    static const double T_95[] =
+    {
+        0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228
+    };
+
+    if (a_measurement.m_samples < 2)
+        return 0.0;
+
+    size_t freedom = a_measurement.m_samples - 1;
+    double t = (freedom <= 10) ? T_95[freedom] : 1.96 + 2.4 / freedom;
+
+    return t * a_measurement.m_deviation / sqrt(static_cast<double>(a_measurement.m_samples));
+}
+
+// is the first measurement better than the second, beyond noise and by at
+//   least the given fraction?
+bool parallel_tester::is_better(const measurement & a_first,
+                                const measurement & a_second,
+                                double a_threshold)
+{
+    if (a_first.m_mean == BOGUS_RUN_TIME)
+        return false;
+
+    if (a_second.m_mean == BOGUS_RUN_TIME)
+        return true;
+
+    double noise = sqrt(confidence(a_first) * confidence(a_first) + confidence(a_second) * confidence(a_second));
+    double gain  = a_second.m_mean - a_first.m_mean;
+
+    return (gain > noise) && (gain > a_threshold * fabs(a_second.m_mean));
+}
+
+//----------------------------------------------------------
+// option polisher
+
+// creation constructor
+option_polisher::option_polisher(const parallel_tester & a_tester,
+                                 listener &              a_listener,
+                                 size_t                  a_passes,
+                                 double                  a_threshold)
+  : m_tester(a_tester),
+    m_listener(a_listener),
+    m_passes(a_passes),
+    m_threshold(a_threshold)
+{
+    // nada
+}
+
+// every option set one step away from the given one
+vector<chromosome> option_polisher::neighbors(const chromosome & a_options, vector<string> & a_moves) const
+{
+    vector<chromosome> result;
+    a_moves.clear();
+
+    // moves name the function an option belongs to
+    const application & target = m_tester.target();
+
+    for (int n = 0; n < a_options.size(); ++n)
+    {
+        // toggle the flag
+        chromosome toggled(a_options);
+        toggled[n]->set_enabled(!toggled[n]->is_enabled());
+        result.push_back(toggled);
+        a_moves.push_back((toggled[n]->is_enabled() ? "enable " : "disable ") + target.get_option_label(n,toggled[n]->get()));
+
+        if (!a_options[n]->is_enabled())
+            continue;
+
+        // nudge tuning values
+        tuning_option * tuning = dynamic_cast<tuning_option *>(a_options[n]);
+
+        if (tuning != NULL)
+        {
+            for (int direction = -1; direction <= 1; direction += 2)
+            {
+                chromosome nudged(a_options);
+                tuning_option * value = dynamic_cast<tuning_option *>(nudged[n]);
+
+                if (value->set_value(tuning->get_value() + direction * tuning->get_step()) != tuning->get_value())
+                {
+                    result.push_back(nudged);
+                    a_moves.push_back("set " + target.get_option_label(n,value->get()));
+                }
+            }
+        }
+
+        // try the other choices of an enumeration
+        enum_option * choices = dynamic_cast<enum_option *>(a_options[n]);
+
+        if (choices != NULL)
+        {
+            for (int c = 0; c < static_cast<int>(choices->get_choices().size()); ++c)
+            {
+                if (c == choices->get_setting())
+                    continue;
+
+                chromosome switched(a_options);
+                dynamic_cast<enum_option *>(switched[n])->set_setting(c);
+                result.push_back(switched);
+                a_moves.push_back("switch to " + target.get_option_label(n,switched[n]->get()));
+            }
+        }
+    }
+
+    return result;
+}
+
+// improve and minimize an option set
+chromosome option_polisher::polish(const chromosome & a_start, measurement & a_result) const
+{
+    chromosome current(a_start);
+    vector<chromosome> batch(1,current);
+    a_result = m_tester.measure(batch)[0];
+
+    ostringstream report;
+    report << "\npolishing best options (" << m_tester.repeats() << " runs per test, "
+           << m_tester.jobs() << " at once), starting fitness " << a_result.m_mean << "\n";
+    m_listener.report(report.str());
+
+    if (a_result.m_mean == BOGUS_RUN_TIME)
+        return current;
+
+    // first-improvement hill climb; a batch of neighbors is tested at once,
+    //   and the best significant improvement in the batch is taken
+    for (size_t pass = 1; pass <= m_passes; ++pass)
+    {
+        bool improved = false;
+        vector<string> moves;
+        vector<chromosome> candidates = neighbors(current,moves);
+
+        for (size_t first = 0; first < candidates.size(); first += m_tester.jobs())
+        {
+            size_t last = min(first + m_tester.jobs(),candidates.size());
+            batch.assign(candidates.begin() + first,candidates.begin() + last);
+
+            vector<measurement> results = m_tester.measure(batch);
+            size_t best = results.size();
+
+            for (size_t n = 0; n < results.size(); ++n)
+            {
+                if (parallel_tester::is_better(results[n],a_result,m_threshold)
+                &&  ((best == results.size()) || (results[n].m_mean < results[best].m_mean)))
+                    best = n;
+            }
+
+            if (best < results.size())
+            {
+                ostringstream move;
+                move << "    pass " << pass << ": " << moves[first + best] << " (" << a_result.m_mean
+                     << " -> " << results[best].m_mean << ")\n";
+                m_listener.report(move.str());
+
+                current  = batch[best];
+                a_result = results[best];
+                improved = true;
+
+                // continue scanning from here, around the new option set
+                candidates = neighbors(current,moves);
+            }
+
+            m_listener.yield();
+        }
+
+        if (!improved)
+            break;
+    }
+
+    // strip flags whose removal makes no measurable difference
+    size_t stripped = 0;
+
+    for (int first = 0; first < current.size(); first += m_tester.jobs())
+    {
+        vector<int> positions;
+        batch.clear();
+
+        for (int n = first; (n < current.size()) && (n < first + static_cast<int>(m_tester.jobs())); ++n)
+        {
+            if (current[n]->is_enabled())
+            {
+                chromosome without(current);
+                without[n]->set_enabled(false);
+                batch.push_back(without);
+                positions.push_back(n);
+            }
+        }
+
+        if (batch.empty())
+            continue;
+
+        vector<measurement> results = m_tester.measure(batch);
+
+        // removals that don't make things measurably worse
+        vector<size_t> neutral;
+
+        for (size_t n = 0; n < results.size(); ++n)
+        {
+            if ((results[n].m_mean != BOGUS_RUN_TIME) && !parallel_tester::is_better(a_result,results[n],m_threshold))
+                neutral.push_back(n);
+        }
+
+        if (neutral.empty())
+            continue;
+
+        // try removing all neutral flags together, then settle for the best one
+        chromosome combined(current);
+
+        for (size_t n = 0; n < neutral.size(); ++n)
+            combined[positions[neutral[n]]]->set_enabled(false);
+
+        measurement combined_result = results[neutral[0]];
+
+        if (neutral.size() > 1)
+        {
+            batch.assign(1,combined);
+            combined_result = m_tester.measure(batch)[0];
+        }
+
+        if ((combined_result.m_mean != BOGUS_RUN_TIME) && !parallel_tester::is_better(a_result,combined_result,m_threshold))
+        {
+            current  = combined;
+            a_result = combined_result;
+            stripped += neutral.size();
+        }
+        else
+        {
+            size_t best = neutral[0];
+
+            for (size_t n = 1; n < neutral.size(); ++n)
+            {
+                if (results[neutral[n]].m_mean < results[best].m_mean)
+                    best = neutral[n];
+            }
+
+            current[positions[best]]->set_enabled(false);
+            a_result = results[best];
+            ++stripped;
+        }
+    }
+
+    report.str(string());
+    report << "    removed " << stripped << " flag(s) with no measurable effect; final fitness "
+           << a_result.m_mean << " +/- " << parallel_tester::confidence(a_result) << "\n";
+    m_listener.report(report.str());
+
+    return current;
 }
 
-acovea_landscape::~acovea_landscape()
+//----------------------------------------------------------
+// option ablation
+
+// creation constructor
+option_ablation::option_ablation(const parallel_tester & a_tester, listener & a_listener)
+  : m_tester(a_tester),
+    m_listener(a_listener)
 {
     // nada
 }
 
-static double run_test(const vector<string> & command,
-                       string temp_name,
-                       listener & listener,
-                       optimization_mode mode)
+// larger effects first
+static bool impact_order(const option_impact & a_left, const option_impact & a_right)
 {
-    // resulting fitness
-    double fitness = 0.0;
-    
-    // allocate array of string pointers for exec
-    char ** argv = new char * [command.size() + 1];
-    
-    // create string representing the command
-    string command_text;
-
-    // fill list and string versions of command    
-    for (int n = 0; n < command.size(); ++n)
-    {
-        // dupe so we know the string doesn't go away
-        argv[n] = strdup(command[n].c_str());
-        command_text += command[n] + " ";
-    }
-    
-    // terminate argument list
-    argv[command.size()] = NULL;
-
-    // create compile process and wait for it to finish
-    pid_t child_pid;
-    int child_retval;
-    child_pid = fork();
+    return fabs(a_left.m_delta) > fabs(a_right.m_delta);
+}
 
-    if (child_pid == 0)
-        execvp(argv[0],argv);
+// measure the impact of options, ranked by size of effect
+vector<option_impact> option_ablation::analyze(const chromosome & a_options,
+                                               const vector<string> & a_candidates) const
+{
+    vector<option_impact> impacts;
 
-    while (0 == waitpid(child_pid,&child_retval,WNOHANG))
-        listener.yield();
-    
-    // we're done compiling; clean up string dupes!
-    for (int n = 0; n < command.size(); ++n)
-        free(argv[n]);
+    // the unmodified options are measured alongside the variants
+    vector<chromosome> variants(1,a_options);
 
-    // make sure compile succeeded before running program
-    if (child_retval == 0)
+    for (int n = 0; n < a_options.size(); ++n)
     {
-        if (mode == OPTIMIZE_SIZE)
+        if (a_options[n]->is_enabled())
         {
-            // get resulting file size and use as fitness
-            struct stat stats;
-            stat(temp_name.c_str(),&stats);
-            fitness = (double)stats.st_size;
+            chromosome without(a_options);
+            without[n]->set_enabled(false);
+            variants.push_back(without);
+
+            option_impact impact = { m_tester.target().get_option_label(n,a_options[n]->get()), true, 0.0, 0.0 };
+            impacts.push_back(impact);
         }
-        else // OPTIMIZE_SPEED or OPTIMIZE_RETVAL
+        else
         {
-            // run the program
-            argv[0] = strdup(temp_name.c_str());
-            argv[1] = "-ga";
-            argv[2] = NULL;
-
-            // constants for I/O descriptors
-            static const int PIPE_IN  = 0;
-            static const int PIPE_OUT = 1;
+            // add disabled options that look promising
+            vector<string> choices = a_options[n]->get_choices();
 
-            // create pipe
-            int fds[2];
-            pipe(fds);
-
-            // fork and exec program
-            child_pid = fork();
-
-            if (child_pid == 0)
+            for (int c = 0; c < static_cast<int>(choices.size()); ++c)
             {
-                // redirect std. output for child
-                close(STDOUT_FILENO);
-                dup2(fds[PIPE_OUT],STDOUT_FILENO);
-                close(fds[PIPE_IN]);
-                close(fds[PIPE_OUT]);
+                if (find(a_candidates.begin(),a_candidates.end(),m_tester.target().get_option_label(n,choices[c])) == a_candidates.end())
+                    continue;
 
-                execve(temp_name.c_str(),argv,NULL);
-            }
+                chromosome with(a_options);
+                with[n]->set_enabled(true);
 
-            // redirect std. input for parent
-            close(STDIN_FILENO);
-            dup2(fds[PIPE_IN],STDIN_FILENO);
-            close(fds[PIPE_IN]);
-            close(fds[PIPE_OUT]);
+                enum_option * choice = dynamic_cast<enum_option *>(with[n]);
 
-            // wait for child to finish
-            while (0 == waitpid(child_pid,&child_retval,WNOHANG))
-                listener.yield();
-            
-            if (mode == OPTIMIZE_SPEED)
-            {
-                if (child_retval == 0)
-                {
-                    // read run time 
-                    double run_time = 0.0;
-                    char temp[32];
-                    fgets(temp,32,stdin);
-                    run_time = atof(temp);
+                if (choice != NULL)
+                    choice->set_setting(c);
 
-                    // free memory
-                    free(argv[0]);
+                variants.push_back(with);
 
-                    // record fitness
-                    fitness = run_time;
-                }
-                else
-                {
-                    // handle application error
-                    ostringstream errormsg;
-                    errormsg << "\nRUN FAILED:\n" << command_text << endl;
-                    listener.report_error(errormsg.str());
-                    fitness = BOGUS_RUN_TIME;
-                }
-            }
-            else // OPTIMIZE_RETVAL
-            {
-                fitness = (double)child_retval;
+                option_impact impact = { m_tester.target().get_option_label(n,with[n]->get()), false, 0.0, 0.0 };
+                impacts.push_back(impact);
             }
         }
     }
-    else
-    {
-        // handle application error
-        ostringstream errormsg;
-        errormsg << "\nCOMPILE FAILED:\n" << command_text << endl;
-        listener.report_error(errormsg.str());
-        fitness = BOGUS_RUN_TIME;
-    }
-    
-    // remove temporary file
-    remove(temp_name.c_str());
 
-    // done
-    return fitness;
-}
+    ostringstream report;
+    report << "\nmeasuring the impact of " << impacts.size() << " option(s) on the final options ("
+           << m_tester.repeats() << " runs per test, " << m_tester.jobs() << " at once)\n";
+    m_listener.report(report.str());
 
-static string get_temp_name()
-{
-    // generate a unique file name
-    uint32_t file_code = 0;     
-    
-    // first try to read /dev/urandom
-    int fd = open ("/dev/urandom", O_RDONLY);
+    vector<measurement> results = m_tester.measure(variants);
 
-    if (fd != -1)
+    if ((results[0].m_mean == BOGUS_RUN_TIME) || (results[0].m_mean == 0.0))
+        return vector<option_impact>();
+
+    double base_noise = parallel_tester::confidence(results[0]);
+
+    for (size_t n = 0; n < impacts.size(); ++n)
     {
-        read(fd, &file_code, 4);
-        close(fd);
-    }
-    else
-        file_code = (uint32_t)time(NULL);
-    
-    char temp_name[32];
-    snprintf(temp_name,32,"/tmp/ACOVEA%08X",file_code);
-    return string(temp_name);    
-}
-        
-double acovea_landscape::test(acovea_organism & a_org, bool a_verbose) const
-{
-    // run a test
-    string temp_name = get_temp_name();
-    
-    a_org.fitness() = run_test(m_target.get_prime_command(m_input_name,temp_name,a_org.genes()),
-                               temp_name,
-                               m_listener,
-                               m_mode);
+        const measurement & variant = results[n + 1];
 
-    // done
-    return a_org.fitness();
-}
+        if (variant.m_mean == BOGUS_RUN_TIME)
+        {
+            // changing this option breaks the program
+            impacts[n].m_delta      = numeric_limits<double>::infinity();
+            impacts[n].m_confidence = 0.0;
+            continue;
+        }
 
-// fitness testing
-double acovea_landscape::test(vector< acovea_organism > & a_population) const
-{
-    double result = 0.0;
-    size_t n = 0;
+        double noise = parallel_tester::confidence(variant);
 
-    // test each org
-    for (vector< acovea_organism >::iterator org = a_population.begin(); org != a_population.end(); ++org)
-    {
-        ++n;
-        m_listener.ping_fitness_test_begin(n);
-        result += test(*org);
-        m_listener.ping_fitness_test_end(n);
-        m_listener.yield();
+        impacts[n].m_delta      = 100.0 * (variant.m_mean - results[0].m_mean) / results[0].m_mean;
+        impacts[n].m_confidence = 100.0 * sqrt(noise * noise + base_noise * base_noise) / results[0].m_mean;
     }
 
-    // done; return average population fitness
-    return result / a_population.size();
+    stable_sort(impacts.begin(),impacts.end(),impact_order);
+
+    return impacts;
 }
 
 //----------------------------------------------------------
@@ -1362,19 +6576,37 @@ double acovea_landscape::test(vector< acovea_organism > & a_population) const
 // the threshold for reporting an option as optimistic or pessimistic
 const double acovea_reporter::MISM_THRESHOLD = 1.5;
 
-acovea_reporter::acovea_reporter(string a_bench_name,
+acovea_reporter::acovea_reporter(const benchmark_suite & a_suite,
                                  size_t a_number_of_populations,
                                  const application & a_target,
                                  acovea_listener & a_listener,
                                  optimization_mode a_mode)
   : reporter<acovea_organism,acovea_landscape>(a_listener),
-    m_input_name(a_bench_name),
+    m_suite(a_suite),
     m_number_of_populations(a_number_of_populations),
     m_target(a_target),
     m_opt_names(),
     m_opt_counts(),
     m_listener(a_listener),
-    m_mode(a_mode)
+    m_mode(a_mode),
+    m_cache(NULL),
+    m_surrogate(NULL),
+    m_polisher(NULL),
+    m_ablation(NULL),
+    m_checkpoint(NULL),
+    m_diversity(NULL),
+    m_filter(NULL),
+    m_fidelity(NULL),
+    m_profiles(NULL),
+    m_seed_output(),
+    m_report_timing(false),
+    m_timing_file(),
+    m_timing_replayed(false),
+    m_first_generation(1),
+    m_counter(NULL),
+    m_start_time(wall_seconds()),
+    m_best_fitness(BOGUS_RUN_TIME),
+    m_last_populations()
 {
     // we don't care about settings, just what they're named
     chromosome options = a_target.get_random_options();
@@ -1386,7 +6618,7 @@ acovea_reporter::acovea_reporter(string a_bench_name,
         
         for (int i = 0; i < choices.size(); ++i)
         {
-            m_opt_names.push_back(choices[i]);
+            m_opt_names.push_back(a_target.get_option_label(n,choices[i]));
         
             m_opt_counts.push_back(vector<unsigned long>(m_number_of_populations + 1));
                     
@@ -1401,6 +6633,48 @@ acovea_reporter::~acovea_reporter()
     // nada
 }
 
+// results on each input, when a suite combines several
+vector<input_result> acovea_reporter::get_input_results(const vector<evaluation_record> & a_records) const
+{
+    vector<input_result> results;
+
+    if (m_suite.is_combined())
+    {
+        for (size_t n = 0; n < m_suite.size(); ++n)
+        {
+            input_result result = { m_suite.get_input(n), a_records[n].m_fitness };
+            results.push_back(result);
+        }
+    }
+
+    return results;
+}
+
+// options of each separately tuned function
+vector< pair<string,string> > acovea_reporter::get_function_results(const chromosome & a_options) const
+{
+    vector< pair<string,string> > results;
+
+    for (size_t f = 0; f < m_target.get_functions().size(); ++f)
+    {
+        results.push_back(make_pair(m_target.get_functions()[f],m_target.get_function_flags(a_options,f)));
+    }
+
+    return results;
+}
+
+// set the checkpoint notified after each generation
+void acovea_reporter::set_checkpoint(run_checkpoint * a_checkpoint, size_t a_first_generation)
+{
+    m_checkpoint       = a_checkpoint;
+    m_first_generation = a_first_generation;
+
+    // a resumed run picks up the statistics of the original
+    if ((m_checkpoint != NULL) && m_checkpoint->is_replaying()
+    &&  (m_checkpoint->get_opt_counts().size() == m_opt_counts.size()))
+        m_opt_counts = m_checkpoint->get_opt_counts();
+}
+
        
 // accumulate counts of options
 void acovea_reporter::accumulate_stats(const chromosome & a_options, int a_pop_no)
@@ -1441,6 +6715,8 @@ bool acovea_reporter::report(const vector< vector< acovea_organism > > & a_popul
                              double & a_fitness,
                              bool a_finished)
 {
+    ACOVEA_TIME_PHASE(report_timer,PHASE_REPORT);
+
     // exit if populations is empty
     if (a_populations.size() < 1U)
         return false;
@@ -1473,158 +6749,405 @@ bool acovea_reporter::report(const vector< vector< acovea_organism > > & a_popul
                 avg_fitness += org->fitness();
             }
         }
-            
-        // accumulate stats based on best organism
-        accumulate_stats(best_one[p].genes(),p);
+            
+        // accumulate stats based on best organism, unless they were restored
+        if ((m_checkpoint == NULL) || !m_checkpoint->is_replaying())
+            accumulate_stats(best_one[p].genes(),p);
+    }
+    
+    // compute average fitness for all organisms
+    avg_fitness /= avg_count;
+    
+    // display report for this generation
+    m_listener.report_generation(a_iteration + m_first_generation - 1,avg_fitness);
+    
+    // a generation restored from a checkpoint has no new tests to describe
+    bool replaying = (m_checkpoint != NULL) && m_checkpoint->is_replaying();
+    
+    // report how many tests were answered by the fingerprint cache
+    if ((m_cache != NULL) && !replaying)
+    {
+        m_listener.report(m_cache->get_stats_text());
+        m_cache->reset_generation_stats();
+    }
+    
+    // report how well the surrogate model predicted this generation
+    if ((m_surrogate != NULL) && !replaying)
+    {
+        m_listener.report(m_surrogate->get_stats_text());
+        m_surrogate->reset_generation_stats();
+    }
+    
+    // report duplicate children bred for this generation
+    if ((m_filter != NULL) && !replaying)
+    {
+        m_listener.report(m_filter->get_stats_text());
+        m_filter->reset_generation_stats();
+    }
+    
+    // report the tests run at each workload scale
+    if ((m_fidelity != NULL) && !replaying)
+    {
+        m_listener.report(m_fidelity->get_stats_text());
+        m_fidelity->reset_generation_stats();
+    }
+
+    if ((m_profiles != NULL) && !replaying)
+    {
+        m_listener.report(m_profiles->get_stats_text());
+        m_profiles->reset_generation_stats();
+    }
+    
+    // report diversity, and adapt operator rates to it before breeding
+    if ((m_diversity != NULL) && !replaying)
+    {
+        diversity measured = m_diversity->update(a_populations,!a_finished);
+
+        m_listener.report_diversity(a_iteration + m_first_generation - 1,
+                                    measured,
+                                    m_diversity->mutation_rate(),
+                                    m_diversity->crossover_rate());
+    }
+    
+    // report testing throughput, for comparing generational and steady-state runs
+    if ((evaluations() > 0.0) && !replaying)
+    {
+        double hours = (wall_seconds() - m_start_time) / 3600.0;
+        ostringstream text;
+
+        text << "throughput: " << sigdig(evaluations(),6) << " tests";
+
+        if (hours > 0.0)
+            text << ", " << sigdig(evaluations() / hours,4) << " per hour";
+
+        text << "\n";
+        m_listener.report(text.str());
+    }
+    
+    // this generation's time is reported once its children are bred, or
+    //   now if there will be none
+    ACOVEA_STOP_PHASE(report_timer);
+
+    m_timing_replayed = replaying;
+
+    if (a_finished)
+        end_generation();
+    
+    // remember the best fitness so far, and the tested populations in case
+    //   the run stops before its last generation
+    for (int p = 0; p < m_number_of_populations; ++p)
+    {
+        if (best_one[p].fitness() < m_best_fitness)
+            m_best_fitness = best_one[p].fitness();
+    }
+
+    // report final statistics
+    if (a_finished)
+        report_results(a_populations);
+    else
+        m_last_populations = a_populations;
+
+    // save the state of the run before breeding the next generation
+    if ((m_checkpoint != NULL) && !a_finished)
+        m_checkpoint->generation_complete(a_populations,a_iteration + m_first_generation - 1,m_opt_counts);
+
+    // clean up    
+    delete [] best_one;
+    
+    return true;
+}
+
+// report where a generation's time went, including breeding its children
+void acovea_reporter::end_generation()
+{
+    if (m_report_timing && !m_timing_replayed)
+        m_listener.report(phase_profile::global().get_stats_text(false));
+
+    phase_profile::global().end_generation();
+    m_timing_replayed = false;
+}
+
+// report final results from the last populations tested
+void acovea_reporter::finish()
+{
+    if (!m_last_populations.empty())
+        report_results(m_last_populations);
+}
+
+// report final results
+void acovea_reporter::report_results(const vector< vector< acovea_organism > > & a_populations)
+{
+    // find best organisms for each population
+    vector<acovea_organism> best_one(m_number_of_populations);
+    acovea_organism best_of_best;
+
+    for (int p = 0; p < m_number_of_populations; ++p)
+    {
+        best_one[p].fitness() = BOGUS_RUN_TIME;
+
+        for (vector< acovea_organism >::const_iterator org = a_populations[p].begin(); org != a_populations[p].end(); ++org)
+        {
+            if (org->fitness() < best_one[p].fitness())
+            {
+                best_of_best = *org;
+                best_one[p] = *org;
+            }
+        }
+    }
+
+    // keep the final populations as seeds for later runs
+    if (!m_seed_output.empty())
+        population_seeder::save(m_seed_output,a_populations);
+
+    // compile results
+    vector<test_result> tests;
+
+    // calculate the mean
+    double mean = 0.0;
+    
+    for (int i = 0; i < m_opt_names.size(); ++i)
+        mean += static_cast<double>(m_opt_counts[i][m_number_of_populations]);
+
+    mean /= static_cast<double>(m_opt_names.size());
+    
+    // calculate variance
+    double variance = 0.0;
+    
+    for (int i = 0; i < m_opt_names.size(); ++i)
+    {
+        double diff = static_cast<double>(m_opt_counts[i][m_number_of_populations]) - mean;
+        variance += (diff * diff);
+    }
+
+    variance /= static_cast<double>(m_opt_names.size());
+
+    // calculate the std. deviation (sigma)
+    double sigma = sqrt(variance);
+
+    // calculate zscores and report
+    vector<option_zscore> zscores;
+    
+    option_zscore oz;
+    
+    for (int i = 0; i < m_opt_names.size(); ++i)
+    {
+        oz.m_name   = m_opt_names[i];
+        oz.m_zscore = sigdig(((static_cast<double>(m_opt_counts[i][m_number_of_populations]) - mean) / sigma),4);
+        zscores.push_back(oz);
+    }
+    
+    // in multi-objective mode, the final Pareto front across all populations
+    if (m_mode == OPTIMIZE_PARETO)
+    {
+        vector<const acovea_organism *> front;
+
+        for (int p = 0; p < m_number_of_populations; ++p)
+        {
+            for (vector< acovea_organism >::const_iterator org = a_populations[p].begin(); org != a_populations[p].end(); ++org)
+            {
+                if ((org->run_time() == BOGUS_RUN_TIME) || (org->code_size() == BOGUS_RUN_TIME))
+                    continue;
+
+                bool keep = true;
+
+                // reject dominated organisms and duplicate trade-offs
+                for (int q = 0; (q < m_number_of_populations) && keep; ++q)
+                {
+                    for (vector< acovea_organism >::const_iterator other = a_populations[q].begin(); other != a_populations[q].end(); ++other)
+                    {
+                        if (other->dominates(*org))
+                        {
+                            keep = false;
+                            break;
+                        }
+                    }
+                }
+
+                for (size_t i = 0; (i < front.size()) && keep; ++i)
+                {
+                    if ((front[i]->run_time() == org->run_time()) && (front[i]->code_size() == org->code_size()))
+                        keep = false;
+                }
+
+                if (keep)
+                    front.push_back(&(*org));
+            }
+        }
+
+        // list from fastest to smallest
+        for (size_t i = 1; i < front.size(); ++i)
+        {
+            for (size_t j = i; (j > 0) && (front[j]->run_time() < front[j - 1]->run_time()); --j)
+                swap(front[j],front[j - 1]);
+        }
+
+        for (size_t i = 0; i < front.size(); ++i)
+        {
+            ostringstream description;
+            description << "Acovea's Pareto Front " << (i + 1) << "/" << front.size();
+
+            test_result result = { description.str(), string(), front[i]->run_time(), true, front[i]->code_size(), vector<input_result>(), vector< pair<string,string> >() };
+            vector<string> command = m_target.get_prime_command(m_suite.get_input(0),get_temp_name(),front[i]->genes());
+
+            for (int n = 0; n < command.size(); ++n)
+                result.m_detail += command[n] + " ";
+
+            result.m_functions = get_function_results(front[i]->genes());
+            tests.push_back(result);
+        }
     }
-    
-    // compute average fitness for all organisms
-    avg_fitness /= avg_count;
-    
-    // display report for this generation
-    m_listener.report_generation(a_iteration,avg_fitness);
-    
-    // report final statistics
-    if (a_finished)
+
+    // the final, best set of options
+    chromosome final_options = best_of_best.genes();
+
+    // refine the best organism by local search
+    if ((m_polisher != NULL) && (final_options.size() > 0))
     {
-        // compile results
-        vector<test_result> tests;
+        measurement polished_fitness;
+        chromosome  polished = m_polisher->polish(final_options,polished_fitness);
+        final_options = polished;
 
-        // calculate the mean
-        double mean = 0.0;
-        
-        for (int i = 0; i < m_opt_names.size(); ++i)
-            mean += static_cast<double>(m_opt_counts[i][m_number_of_populations]);
+        test_result polished_result = { "Acovea's Polished Options", string(), polished_fitness.m_mean, true, 0.0, vector<input_result>(), vector< pair<string,string> >() };
+        vector<string> polished_command = m_target.get_prime_command(m_suite.get_input(0),get_temp_name(),polished);
 
-        mean /= static_cast<double>(m_opt_names.size());
-        
-        // calculate variance
-        double variance = 0.0;
-        
-        for (int i = 0; i < m_opt_names.size(); ++i)
+        for (int n = 0; n < polished_command.size(); ++n)
+            polished_result.m_detail += polished_command[n] + " ";
+
+        polished_result.m_functions = get_function_results(polished);
+        tests.push_back(polished_result);
+    }
+
+    // measure what each option contributes to the final options
+    vector<option_impact> impacts;
+
+    if ((m_ablation != NULL) && (final_options.size() > 0))
+    {
+        // options that look promising, but aren't in the final set
+        vector<string> optimistic;
+
+        for (int i = 0; i < zscores.size(); ++i)
         {
-            double diff = static_cast<double>(m_opt_counts[i][m_number_of_populations]) - mean;
-            variance += (diff * diff);
+            if (zscores[i].m_zscore >= MISM_THRESHOLD)
+                optimistic.push_back(zscores[i].m_name);
         }
 
-        variance /= static_cast<double>(m_opt_names.size());
+        impacts = m_ablation->analyze(final_options,optimistic);
+    }
 
-        // calculate the std. deviation (sigma)
-        double sigma = sqrt(variance);
+    // only display common options if more than one population
+    if (m_number_of_populations > 1)
+    {
+        // using best fitnesses, compute "common" genes for multiple populations
+        //chromosome optopt_options = best_of_best.genes();
+        chromosome common_options = best_of_best.genes();
+        chromosome empty_options  = best_of_best.genes();
 
-        // calculate zscores and report
-        vector<option_zscore> zscores;
-        
-        option_zscore oz;
-        
-        for (int i = 0; i < m_opt_names.size(); ++i)
+        for (int n = 0, n2 = 0; n < empty_options.size(); ++n, ++n2)
         {
-            oz.m_name   = m_opt_names[i];
-            oz.m_zscore = sigdig(((static_cast<double>(m_opt_counts[i][m_number_of_populations]) - mean) / sigma),4);
-            zscores.push_back(oz);
+            // optopt_options[n]->set_enabled(zscores[n].m_zscore >= MISM_THRESHOLD);
+            empty_options[n]->set_enabled(false);
         }
         
-        // only display common options if more than one population
-        if (m_number_of_populations > 1)
+        for (int p = 0; p < m_number_of_populations; ++p)
         {
-            // using best fitnesses, compute "common" genes for multiple populations
-            //chromosome optopt_options = best_of_best.genes();
-            chromosome common_options = best_of_best.genes();
-            chromosome empty_options  = best_of_best.genes();
-
-            for (int n = 0, n2 = 0; n < empty_options.size(); ++n, ++n2)
-            {
-                // optopt_options[n]->set_enabled(zscores[n].m_zscore >= MISM_THRESHOLD);
-                empty_options[n]->set_enabled(false);
-            }
-            
-            for (int p = 0; p < m_number_of_populations; ++p)
+            // keep shared genes
+            if (p != 0)
             {
-                // keep shared genes
-                if (p != 0)
-                {
-                    chromosome temp = best_one[p].genes();
+                chromosome temp = best_one[p].genes();
 
-                    for (int n = 0; n < common_options.size(); ++n)
-                        common_options[n]->set_enabled(common_options[n]->is_enabled() & temp[n]->is_enabled());
-                }
+                for (int n = 0; n < common_options.size(); ++n)
+                    common_options[n]->set_enabled(common_options[n]->is_enabled() & temp[n]->is_enabled());
             }
+        }
 
-            // for common tuning option, average the assigned values
-            /*
-            for (int n = 0; n < common_options.size(); ++n)
+        // for common tuning option, average the assigned values
+        /*
+        for (int n = 0; n < common_options.size(); ++n)
+        {
+            if (common_options[n]->is_enabled() & common_options[n]->has_settings())
             {
-                if (common_options[n]->is_enabled() & common_options[n]->has_settings())
-                {
-                    cout << "tuning option" << endl;
-                    long sum = 0;
-                    for (int p = 0; p < m_number_of_populations; ++p)
-                        sum += dynamic_cast<const tuning_option *>(a_populations[p][n])->get_value();
+                cout << "tuning option" << endl;
+                long sum = 0;
+                for (int p = 0; p < m_number_of_populations; ++p)
+                    sum += dynamic_cast<const tuning_option *>(a_populations[p][n])->get_value();
 
-                    // set common option to average
-                    dynamic_cast<tuning_option *>(common_options[n])->set_value(sum / m_number_of_populations);
-                }
+                // set common option to average
+                dynamic_cast<tuning_option *>(common_options[n])->set_value(sum / m_number_of_populations);
             }
-            */
+        }
+        */
 
-            // get application strings
-            //string optopt_temp_name = get_temp_name();
-            string bestof_temp_name = get_temp_name();
-            string common_temp_name = get_temp_name();
-            
-            //vector<string> optopt_command = m_target.get_prime_command(m_input_name,optopt_temp_name,optopt_options);
-            vector<string> bestof_command = m_target.get_prime_command(m_input_name,bestof_temp_name,best_of_best.genes());
-            vector<string> common_command = m_target.get_prime_command(m_input_name,common_temp_name,common_options);
-            
-            //test_result optopt_result = { "Acovea's Optimistic Options", string(), 0.0, true };
-            test_result bestof_result = { "Acovea's Best-of-the-Best", string(), 0.0, true };
-            test_result common_result = { "Acovea's Common Options", string(), 0.0, true };
+        // get application strings
+        //string optopt_temp_name = get_temp_name();
+        string bestof_temp_name = get_temp_name();
+        string common_temp_name = get_temp_name();
+        
+        //vector<string> optopt_command = m_target.get_prime_command(m_input_name,optopt_temp_name,optopt_options);
+        vector<string> bestof_command = m_target.get_prime_command(m_suite.get_input(0),bestof_temp_name,best_of_best.genes());
+        vector<string> common_command = m_target.get_prime_command(m_suite.get_input(0),common_temp_name,common_options);
+        
+        //test_result optopt_result = { "Acovea's Optimistic Options", string(), 0.0, true };
+        test_result bestof_result = { "Acovea's Best-of-the-Best", string(), 0.0, true, 0.0, vector<input_result>(), vector< pair<string,string> >() };
+        test_result common_result = { "Acovea's Common Options", string(), 0.0, true, 0.0, vector<input_result>(), vector< pair<string,string> >() };
+        
+        // sizes are only reported alongside run times in multi-objective mode
+        double * bestof_size = (m_mode == OPTIMIZE_PARETO) ? &bestof_result.m_code_size : NULL;
+        double * common_size = (m_mode == OPTIMIZE_PARETO) ? &common_result.m_code_size : NULL;
+        vector<evaluation_record> input_records;
+        
+        //optopt_result.m_fitness = run_test(optopt_command,optopt_temp_name,m_listener,m_mode);
+        bestof_result.m_fitness = run_suite(m_suite,m_target,NULL,best_of_best.genes(),m_listener,m_mode,NULL,m_profiles,bestof_size,1.0,&input_records);
+        bestof_result.m_inputs  = get_input_results(input_records);
+        bestof_result.m_functions = get_function_results(best_of_best.genes());
+        common_result.m_fitness = run_suite(m_suite,m_target,NULL,common_options,m_listener,m_mode,NULL,m_profiles,common_size,1.0,&input_records);
+        common_result.m_inputs  = get_input_results(input_records);
+        common_result.m_functions = get_function_results(common_options);
+
+        //for (int n = 0; n < optopt_command.size(); ++n)
+        //    optopt_result.m_detail += optopt_command[n] + " ";
+
+        for (int n = 0; n < bestof_command.size(); ++n)
+            bestof_result.m_detail += bestof_command[n] + " ";
+
+        for (int n = 0; n < common_command.size(); ++n)
+            common_result.m_detail += common_command[n] + " ";
+
+        //tests.push_back(optopt_result);
+        tests.push_back(bestof_result);
+        tests.push_back(common_result);
+        
+        // add the baselines
+        vector<command_elements> baselines = m_target.get_baselines();
+        
+        for (int n = 0; n < baselines.size(); ++n)
+        {
+            test_result result;
+            string      temp_name = get_temp_name();
             
-            //optopt_result.m_fitness = run_test(optopt_command,optopt_temp_name,m_listener,m_mode);
-            bestof_result.m_fitness = run_test(bestof_command,bestof_temp_name,m_listener,m_mode);
-            common_result.m_fitness = run_test(common_command,common_temp_name,m_listener,m_mode);
-
-            //for (int n = 0; n < optopt_command.size(); ++n)
-            //    optopt_result.m_detail += optopt_command[n] + " ";
-
-            for (int n = 0; n < bestof_command.size(); ++n)
-                bestof_result.m_detail += bestof_command[n] + " ";
-
-            for (int n = 0; n < common_command.size(); ++n)
-                common_result.m_detail += common_command[n] + " ";
-
-            //tests.push_back(optopt_result);
-            tests.push_back(bestof_result);
-            tests.push_back(common_result);
+            result.m_description      = baselines[n].m_description;
+            result.m_acovea_generated = false;
+            result.m_code_size        = 0.0;
+            vector<string> command    = m_target.get_command(baselines[n],m_suite.get_input(0),temp_name,empty_options);
+            result.m_fitness          = run_suite(m_suite,m_target,&baselines[n],empty_options,m_listener,m_mode,NULL,NULL,
+                                                  (m_mode == OPTIMIZE_PARETO) ? &result.m_code_size : NULL,1.0,&input_records);
+            result.m_inputs           = get_input_results(input_records);
             
-            // add the baselines
-            vector<command_elements> baselines = m_target.get_baselines();
+            for (int n = 0; n < command.size(); ++n)
+                result.m_detail += command[n] + " ";
             
-            for (int n = 0; n < baselines.size(); ++n)
-            {
-                test_result result;
-                string      temp_name = get_temp_name();
-                
-                result.m_description      = baselines[n].m_description;
-                result.m_acovea_generated = false;
-                vector<string> command    = m_target.get_command(baselines[n],m_input_name,temp_name,empty_options);
-                result.m_fitness          = run_test(command,temp_name,m_listener,m_mode);
-                
-                for (int n = 0; n < command.size(); ++n)
-                    result.m_detail += command[n] + " ";
-                
-                tests.push_back(result);
-            }
+            tests.push_back(result);
         }
-
-        // send results to listener
-        m_listener.report_final(tests,zscores);
     }
 
-    // clean up    
-    delete [] best_one;
-    
-    return true;
+    // where the whole run's time went
+    if (m_report_timing)
+        m_listener.report(phase_profile::global().get_stats_text(true));
+
+    if (!m_timing_file.empty())
+        phase_profile::global().write(m_timing_file);
+
+    // send results to listener
+    m_listener.report_final(tests,zscores,impacts);
 }
 
 void acovea_listener_stdout::ping_generation_begin(size_t a_generation_number)
@@ -1683,6 +7206,28 @@ void acovea_listener_stdout::report_config(const string & a_text)
     cout << a_text;
 }
 
+// send population diversity and operator rates
+void acovea_listener::report_diversity(size_t a_gen_no,
+                                       const diversity & a_diversity,
+                                       double a_mutation_rate,
+                                       double a_crossover_rate)
+{
+    ostringstream text;
+
+    text << "diversity: distance " << sigdig(a_diversity.m_distance,3)
+         << ", entropy " << sigdig(a_diversity.m_entropy,3)
+         << "; mutation rate " << sigdig(a_mutation_rate,3)
+         << ", crossover rate " << sigdig(a_crossover_rate,3) << "\n";
+
+    report(text.str());
+}
+
+// send the details of one compile-and-run test
+void acovea_listener::report_evaluation(const evaluation_record & a_record)
+{
+    // nada
+}
+
 void acovea_listener_stdout::report_generation(size_t a_gen_no, double  a_avg_fitness)
 {
     cout << "\n\ngeneration " << a_gen_no
@@ -1690,7 +7235,9 @@ void acovea_listener_stdout::report_generation(size_t a_gen_no, double  a_avg_fi
          << endl;
 }
 
-void acovea_listener_stdout::report_final(vector<test_result> & a_results, vector<option_zscore> & a_zscores)
+void acovea_listener_stdout::report_final(vector<test_result> & a_results,
+                                          vector<option_zscore> & a_zscores,
+                                          vector<option_impact> & a_impacts)
 {
     static const double rTHRESHOLD = 1.5;
     
@@ -1736,6 +7283,31 @@ void acovea_listener_stdout::report_final(vector<test_result> & a_results, vecto
     if (!flag)
         cout << "        none" << endl;
     
+    // measured impacts, largest first
+    if (a_impacts.size() > 0)
+    {
+        cout << "\nMeasured option impact (change in fitness, 95% confidence):\n\n";
+
+        for (int n = 0; n < a_impacts.size(); ++n)
+        {
+            cout << right << setw(40) << a_impacts[n].m_name
+                 << (a_impacts[n].m_removed ? "  removed: " : "    added: ");
+
+            if (a_impacts[n].m_delta == numeric_limits<double>::infinity())
+                cout << "  fails\n";
+            else
+            {
+                cout << showpos << fixed << setprecision(2) << setw(8) << a_impacts[n].m_delta << noshowpos
+                     << "% +/- " << setprecision(2) << a_impacts[n].m_confidence << "%"
+                     << ((fabs(a_impacts[n].m_delta) > a_impacts[n].m_confidence) ? "" : "  (noise)")
+                     << "\n";
+            }
+        }
+
+        cout.unsetf(ios::fixed);
+        cout << setprecision(6);
+    }
+    
     // graph test results
     double big_fit = numeric_limits<double>::min();
         
@@ -1745,27 +7317,487 @@ void acovea_listener_stdout::report_final(vector<test_result> & a_results, vecto
              << a_results[n].m_detail
              << endl;
 
-        if (a_results[n].m_fitness > big_fit)
-            big_fit = a_results[n].m_fitness;
+        if (a_results[n].m_code_size > 0.0)
+            cout << "    run time: " << a_results[n].m_fitness
+                 << ", size: " << static_cast<unsigned long>(a_results[n].m_code_size) << " bytes" << endl;
+
+        for (size_t i = 0; i < a_results[n].m_inputs.size(); ++i)
+            cout << "    " << a_results[n].m_inputs[i].m_input << ": " << a_results[n].m_inputs[i].m_fitness << endl;
+
+        for (size_t i = 0; i < a_results[n].m_functions.size(); ++i)
+            cout << "    function " << a_results[n].m_functions[i].first << ": "
+                 << (a_results[n].m_functions[i].second.empty() ? string("none") : a_results[n].m_functions[i].second) << endl;
+
+        if (a_results[n].m_fitness > big_fit)
+            big_fit = a_results[n].m_fitness;
+    }
+    
+    cout << "\n\nA relative graph of fitnesses:\n";
+    
+    for (int n = 0; n < a_results.size(); ++n)
+    {
+        cout << "\n" << right << setw(30) << a_results[n].m_description << ": ";
+        
+        int count = int(a_results[n].m_fitness / big_fit * 50.1);
+        
+        for (int i = 0; i < count; ++i)
+            cout << "*";
+        
+        cout << right << setw(55 - count) << " ("
+             << a_results[n].m_fitness;
+
+        if (a_results[n].m_code_size > 0.0)
+            cout << ", " << static_cast<unsigned long>(a_results[n].m_code_size) << " bytes";
+
+        cout << ")";
+    }
+    
+    cout << "\n\nAcovea is done.\n" << endl;
+}
+
+//----------------------------------------------------------
+// buffered event log
+
+// buffered text that wakes the writer before its next scheduled write
+static const size_t EVENT_LOG_CHUNK = 65536;
+
+// longest time a line waits in the buffer, in microseconds
+static const long EVENT_LOG_DELAY = 250000;
+
+// lines waiting to be written, and the lock and signal guarding them
+struct event_log_writer::writer_state
+{
+    string          m_pending;
+    pthread_mutex_t m_lock;
+    pthread_cond_t  m_wake;
+    bool            m_stopping;
+    pthread_t       m_thread;
+};
+
+// creation constructor; opens the file
+event_log_writer::event_log_writer(const string & a_file_name)
+  : m_file(fopen(a_file_name.c_str(),"w")),
+    m_state(NULL),
+    m_owner(getpid())
+{
+    if (m_file == NULL)
+        throw runtime_error("unable to create event log " + a_file_name);
+
+    m_state = new writer_state;
+    m_state->m_stopping = false;
+
+    pthread_mutex_init(&m_state->m_lock,NULL);
+    pthread_cond_init(&m_state->m_wake,NULL);
+
+    if (pthread_create(&m_state->m_thread,NULL,run_thread,this) != 0)
+    {
+        pthread_cond_destroy(&m_state->m_wake);
+        pthread_mutex_destroy(&m_state->m_lock);
+        delete m_state;
+        fclose(m_file);
+        throw runtime_error("unable to start event log writer");
+    }
+}
+
+// destructor; writes anything still buffered
+event_log_writer::~event_log_writer()
+{
+    pthread_mutex_lock(&m_state->m_lock);
+    m_state->m_stopping = true;
+    pthread_cond_signal(&m_state->m_wake);
+    pthread_mutex_unlock(&m_state->m_lock);
+
+    pthread_join(m_state->m_thread,NULL);
+
+    pthread_cond_destroy(&m_state->m_wake);
+    pthread_mutex_destroy(&m_state->m_lock);
+    delete m_state;
+    fclose(m_file);
+}
+
+// queue a line (the newline is added)
+void event_log_writer::write(const string & a_line)
+{
+    // a forked test process has a copy of the buffer, but no writer
+    if (getpid() != m_owner)
+        return;
+
+    pthread_mutex_lock(&m_state->m_lock);
+
+    m_state->m_pending += a_line;
+    m_state->m_pending += '\n';
+    bool full = (m_state->m_pending.size() >= EVENT_LOG_CHUNK);
+
+    pthread_mutex_unlock(&m_state->m_lock);
+
+    if (full)
+        pthread_cond_signal(&m_state->m_wake);
+}
+
+void * event_log_writer::run_thread(void * a_writer)
+{
+    static_cast<event_log_writer *>(a_writer)->run();
+    return NULL;
+}
+
+// background thread: swap the buffer out and write it, with the lock released
+void event_log_writer::run()
+{
+    string batch;
+    bool   stopping = false;
+
+    pthread_mutex_lock(&m_state->m_lock);
+
+    while (!stopping)
+    {
+        if ((m_state->m_pending.size() < EVENT_LOG_CHUNK) && !m_state->m_stopping)
+        {
+            struct timeval  now;
+            struct timespec deadline;
+
+            gettimeofday(&now,NULL);
+            deadline.tv_sec  = now.tv_sec + (now.tv_usec + EVENT_LOG_DELAY) / 1000000;
+            deadline.tv_nsec = ((now.tv_usec + EVENT_LOG_DELAY) % 1000000) * 1000;
+
+            pthread_cond_timedwait(&m_state->m_wake,&m_state->m_lock,&deadline);
+        }
+
+        // both buffers keep their capacity, so steady logging doesn't allocate
+        batch.swap(m_state->m_pending);
+        stopping = m_state->m_stopping;
+
+        pthread_mutex_unlock(&m_state->m_lock);
+
+        if (!batch.empty())
+        {
+            fwrite(batch.data(),1,batch.size(),m_file);
+            fflush(m_file);
+            batch.clear();
+        }
+
+        pthread_mutex_lock(&m_state->m_lock);
+    }
+
+    pthread_mutex_unlock(&m_state->m_lock);
+}
+
+//----------------------------------------------------------
+// JSON-lines listener
+
+// text as a JSON string
+static string json_string(const string & a_text)
+{
+    string result("\"");
+
+    for (string::const_iterator c = a_text.begin(); c != a_text.end(); ++c)
+    {
+        switch (*c)
+        {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    char code[8];
+                    snprintf(code,8,"\\u%04x",static_cast<unsigned int>(static_cast<unsigned char>(*c)));
+                    result += code;
+                }
+                else
+                    result += *c;
+        }
+    }
+
+    result += '"';
+    return result;
+}
+
+// a number as JSON; failures and infinities, which JSON can't express, are null
+static string json_number(double a_value)
+{
+    if ((a_value != a_value) || (fabs(a_value) == numeric_limits<double>::infinity()) || (a_value == BOGUS_RUN_TIME))
+        return string("null");
+
+    char text[32];
+    snprintf(text,32,"%.10g",a_value);
+    return string(text);
+}
+
+static string json_numbers(const vector<double> & a_values)
+{
+    string result("[");
+
+    for (size_t n = 0; n < a_values.size(); ++n)
+    {
+        if (n > 0)
+            result += ",";
+
+        result += json_number(a_values[n]);
+    }
+
+    result += "]";
+    return result;
+}
+
+// benchmark fields, as numbers where they are numbers
+static string json_metrics(const map<string,string> & a_fields)
+{
+    string result("{");
+
+    for (map<string,string>::const_iterator field = a_fields.begin(); field != a_fields.end(); ++field)
+    {
+        if (field != a_fields.begin())
+            result += ",";
+
+        const char * text = field->second.c_str();
+        char * end = NULL;
+        double value = strtod(text,&end);
+
+        result += json_string(field->first) + ":";
+
+        // hexadecimal values (checksums) stay text, to keep every digit
+        if ((end != text) && (*end == 0) && (field->second.find_first_of("xX") == string::npos))
+            result += json_number(value);
+        else
+            result += json_string(field->second);
+    }
+
+    return result + "}";
+}
+
+// creation constructor
+acovea_listener_json::acovea_listener_json(const string & a_file_name, acovea_listener & a_next)
+  : m_log(a_file_name),
+    m_next(a_next),
+    m_start_time(wall_seconds()),
+    m_generation(0),
+    m_evaluations(0),
+    m_cache_hits(0),
+    m_failures(0),
+    m_best_fitness(BOGUS_RUN_TIME)
+{
+    // nada
+}
+
+// start an event object with its name and time
+string acovea_listener_json::begin_event(const char * a_name) const
+{
+    char text[96];
+    snprintf(text,96,"{\"event\":\"%s\",\"time\":%.6f",a_name,wall_seconds() - m_start_time);
+    return string(text);
+}
+
+void acovea_listener_json::ping_generation_begin(size_t a_generation_number)
+{
+    m_generation   = a_generation_number;
+    m_evaluations  = 0;
+    m_cache_hits   = 0;
+    m_failures     = 0;
+    m_best_fitness = BOGUS_RUN_TIME;
+
+    ostringstream event;
+    event << begin_event("generation_begin") << ",\"generation\":" << a_generation_number << "}";
+    m_log.write(event.str());
+
+    m_next.ping_generation_begin(a_generation_number);
+}
+
+void acovea_listener_json::ping_generation_end(size_t a_generation_number)
+{
+    m_next.ping_generation_end(a_generation_number);
+}
+
+void acovea_listener_json::ping_population_begin(size_t a_population_number)
+{
+    ostringstream event;
+    event << begin_event("population_begin") << ",\"generation\":" << m_generation
+          << ",\"population\":" << a_population_number << "}";
+    m_log.write(event.str());
+
+    m_next.ping_population_begin(a_population_number);
+}
+
+void acovea_listener_json::ping_population_end(size_t a_population_number)
+{
+    m_next.ping_population_end(a_population_number);
+}
+
+void acovea_listener_json::ping_fitness_test_begin(size_t a_organism_number)
+{
+    m_next.ping_fitness_test_begin(a_organism_number);
+}
+
+void acovea_listener_json::ping_fitness_test_end(size_t a_organism_number)
+{
+    m_next.ping_fitness_test_end(a_organism_number);
+}
+
+void acovea_listener_json::report(const string & a_text)
+{
+    m_log.write(begin_event("text") + ",\"text\":" + json_string(a_text) + "}");
+    m_next.report(a_text);
+}
+
+void acovea_listener_json::report_error(const string & a_text)
+{
+    m_log.write(begin_event("error") + ",\"text\":" + json_string(a_text) + "}");
+    m_next.report_error(a_text);
+}
+
+void acovea_listener_json::run_complete()
+{
+    m_log.write(begin_event("complete") + "}");
+    m_next.run_complete();
+}
+
+void acovea_listener_json::yield()
+{
+    m_next.yield();
+}
+
+void acovea_listener_json::report_config(const string & a_text)
+{
+    m_log.write(begin_event("config") + ",\"text\":" + json_string(a_text) + "}");
+    m_next.report_config(a_text);
+}
+
+void acovea_listener_json::report_generation(size_t a_gen_no, double a_avg_fitness)
+{
+    ostringstream event;
+    event << begin_event("generation") << ",\"generation\":" << a_gen_no
+          << ",\"average_fitness\":" << json_number(a_avg_fitness)
+          << ",\"best_fitness\":" << json_number(m_best_fitness)
+          << ",\"evaluations\":" << m_evaluations
+          << ",\"cache_hits\":" << m_cache_hits
+          << ",\"failures\":" << m_failures << "}";
+    m_log.write(event.str());
+
+    m_next.report_generation(a_gen_no,a_avg_fitness);
+}
+
+void acovea_listener_json::report_final(vector<test_result> & a_results,
+                                        vector<option_zscore> & a_zscores,
+                                        vector<option_impact> & a_impacts)
+{
+    ostringstream event;
+    event << begin_event("final") << ",\"results\":[";
+
+    for (size_t n = 0; n < a_results.size(); ++n)
+    {
+        event << ((n > 0) ? "," : "")
+              << "{\"description\":" << json_string(a_results[n].m_description)
+              << ",\"command\":" << json_string(a_results[n].m_detail)
+              << ",\"fitness\":" << json_number(a_results[n].m_fitness)
+              << ",\"acovea_generated\":" << (a_results[n].m_acovea_generated ? "true" : "false")
+              << ",\"code_size\":" << json_number(a_results[n].m_code_size);
+
+        if (!a_results[n].m_inputs.empty())
+        {
+            event << ",\"inputs\":{";
+
+            for (size_t i = 0; i < a_results[n].m_inputs.size(); ++i)
+                event << ((i > 0) ? "," : "") << json_string(a_results[n].m_inputs[i].m_input)
+                      << ":" << json_number(a_results[n].m_inputs[i].m_fitness);
+
+            event << "}";
+        }
+
+        if (!a_results[n].m_functions.empty())
+        {
+            event << ",\"functions\":{";
+
+            for (size_t i = 0; i < a_results[n].m_functions.size(); ++i)
+                event << ((i > 0) ? "," : "") << json_string(a_results[n].m_functions[i].first)
+                      << ":" << json_string(a_results[n].m_functions[i].second);
+
+            event << "}";
+        }
+
+        event << "}";
+    }
+
+    event << "],\"zscores\":[";
+
+    for (size_t n = 0; n < a_zscores.size(); ++n)
+    {
+        event << ((n > 0) ? "," : "")
+              << "{\"option\":" << json_string(a_zscores[n].m_name)
+              << ",\"zscore\":" << json_number(a_zscores[n].m_zscore) << "}";
     }
-    
-    cout << "\n\nA relative graph of fitnesses:\n";
-    
-    for (int n = 0; n < a_results.size(); ++n)
+
+    event << "],\"impacts\":[";
+
+    for (size_t n = 0; n < a_impacts.size(); ++n)
     {
-        cout << "\n" << right << setw(30) << a_results[n].m_description << ": ";
-        
-        int count = int(a_results[n].m_fitness / big_fit * 50.1);
-        
-        for (int i = 0; i < count; ++i)
-            cout << "*";
-        
-        cout << right << setw(55 - count) << " ("
-             << a_results[n].m_fitness
-             << ")";
+        event << ((n > 0) ? "," : "")
+              << "{\"option\":" << json_string(a_impacts[n].m_name)
+              << ",\"removed\":" << (a_impacts[n].m_removed ? "true" : "false")
+              << ",\"delta\":" << json_number(a_impacts[n].m_delta)
+              << ",\"confidence\":" << json_number(a_impacts[n].m_confidence) << "}";
     }
-    
-    cout << "\n\nAcovea is done.\n" << endl;
+
+    event << "]}";
+    m_log.write(event.str());
+
+    m_next.report_final(a_results,a_zscores,a_impacts);
+}
+
+void acovea_listener_json::report_diversity(size_t a_gen_no,
+                                            const diversity & a_diversity,
+                                            double a_mutation_rate,
+                                            double a_crossover_rate)
+{
+    ostringstream event;
+    event << begin_event("diversity") << ",\"generation\":" << a_gen_no
+          << ",\"distance\":" << json_number(a_diversity.m_distance)
+          << ",\"entropy\":" << json_number(a_diversity.m_entropy)
+          << ",\"mutation_rate\":" << json_number(a_mutation_rate)
+          << ",\"crossover_rate\":" << json_number(a_crossover_rate) << "}";
+    m_log.write(event.str());
+
+    m_next.report_diversity(a_gen_no,a_diversity,a_mutation_rate,a_crossover_rate);
+}
+
+void acovea_listener_json::report_evaluation(const evaluation_record & a_record)
+{
+    ++m_evaluations;
+
+    if (a_record.m_cache_hit)
+        ++m_cache_hits;
+
+    if (a_record.m_fitness == BOGUS_RUN_TIME)
+        ++m_failures;
+    else if (a_record.m_fitness < m_best_fitness)
+        m_best_fitness = a_record.m_fitness;
+
+    ostringstream event;
+    event << begin_event("evaluation") << ",\"generation\":" << m_generation
+          << ",\"options\":" << json_string(a_record.m_options)
+          << ",\"command\":" << json_string(a_record.m_command)
+          << ",\"compiled\":" << (a_record.m_compiled ? "true" : "false")
+          << ",\"exit_status\":" << a_record.m_exit_status
+          << ",\"compile_seconds\":" << json_number(a_record.m_compile_seconds)
+          << ",\"run_seconds\":" << json_numbers(a_record.m_run_seconds)
+          << ",\"samples\":" << json_numbers(a_record.m_samples)
+          << ",\"metrics\":" << json_metrics(a_record.m_metrics)
+          << ",\"scale\":" << json_number(a_record.m_scale)
+          << ",\"cache_hit\":" << (a_record.m_cache_hit ? "true" : "false")
+          << ",\"fitness\":" << json_number(a_record.m_fitness) << "}";
+    m_log.write(event.str());
+
+    m_next.report_evaluation(a_record);
 }
 
 // constructor
@@ -1780,21 +7812,88 @@ acovea_world::acovea_world(acovea_listener & a_listener,
                            double a_mutation_rate,
                            double a_crossover_rate,
                            bool   a_use_scaling,
-                           size_t a_generations)
+                           size_t a_generations,
+                           const run_settings & a_settings)
   : m_generations(a_generations),
+    m_counter(a_listener),
     m_target(a_target),
-    m_listener(a_listener),
-    m_input_name(a_bench_name),
+    m_listener(m_counter),
+    m_suite(a_bench_name),
+    m_number_of_populations(a_number_of_populations),
+    m_population_size(a_population_size),
     m_mutator(a_mutation_rate, a_target),
     m_reproducer(a_crossover_rate, a_target),
     m_migrator(size_t(a_population_size * a_migration_rate + 0.5)),
     m_null_scaler(),
     m_sigma_scaler(),
     m_selector(size_t(a_population_size * a_survival_rate + 0.5)),
-    m_reporter(a_bench_name,a_number_of_populations,a_target,a_listener,a_mode),
+    m_reporter(m_suite,a_number_of_populations,a_target,m_counter,a_mode),
     m_evocosm(NULL),
-    m_mode(a_mode)
+    m_mode(a_mode),
+    m_settings(a_settings),
+    m_cache(a_settings.m_cache_code_only,a_settings.m_cache_refine),
+    m_surrogate(a_target),
+    m_diversity(m_mutator,m_reproducer,a_settings.m_adaptive_rates,a_settings.m_diversity_low,a_settings.m_diversity_high),
+    m_filter(a_settings.m_unique_history,a_settings.m_unique_retries),
+    m_fidelity(((a_mode == OPTIMIZE_SPEED) && !a_settings.m_steady_state) ? a_settings.m_fidelity_scale : 0.0,
+               a_settings.m_fidelity_promote),
+    m_profiles(a_target,m_counter),
+    m_seeder(a_target,a_settings.m_seed_fraction,a_settings.m_seed_mutation),
+    m_tester(m_suite,a_mode,a_target,m_counter,a_settings.m_jobs,a_settings.m_repeats,a_settings.m_fork_server),
+    m_polisher(m_tester,m_counter,a_settings.m_polish_passes,a_settings.m_polish_threshold),
+    m_ablation(m_tester,m_counter),
+    m_checkpoint(a_target,
+                 a_settings.m_checkpoint_file.empty() ? a_settings.m_resume_file : a_settings.m_checkpoint_file,
+                 a_settings.m_checkpoint_every,
+                 a_settings.m_checkpoint_minutes,
+                 a_settings.m_use_cache ? &m_cache : NULL,
+                 a_settings.m_use_surrogate ? &m_surrogate : NULL,
+                 a_settings.m_adaptive_rates ? &m_diversity : NULL,
+                 a_settings.m_unique_children ? &m_filter : NULL),
+    m_first_generation(1),
+    m_transport(NULL),
+    m_island_migrator(NULL),
+    m_terminated(false),
+    m_budget(a_settings)
 {
+    // checksums come from running the benchmark
+    if (m_settings.m_verify && (a_mode == OPTIMIZE_SIZE))
+        throw runtime_error("checksum verification does not apply to size optimization");
+
+    m_suite.set_tolerance(m_settings.m_verify_tolerance);
+
+    // the budget counts the tests actually run
+    m_counter.set_inputs(m_suite.size());
+    m_reporter.set_test_counter(&m_counter);
+
+    // steady-state runs have no generations to rank or to checkpoint
+    if (m_settings.m_steady_state && (a_mode == OPTIMIZE_PARETO))
+        throw runtime_error("steady-state evolution does not support Pareto optimization");
+
+    if (m_settings.m_steady_state && (!m_settings.m_checkpoint_file.empty() || !m_settings.m_resume_file.empty()))
+        throw runtime_error("steady-state evolution does not support checkpoints");
+
+    // Pareto fitness is a rank, not a measurement that can improve or meet a target
+    if ((a_mode == OPTIMIZE_PARETO) && ((m_settings.m_target_ratio > 0.0) || (m_settings.m_stall_generations > 0)))
+        throw runtime_error("target and stall limits do not apply to Pareto optimization");
+
+    // pick up where a previous run left off
+    if (!m_settings.m_resume_file.empty())
+        m_first_generation = m_checkpoint.load(m_settings.m_resume_file,a_number_of_populations,a_population_size);
+
+    // known option lists to start from
+    if (m_settings.m_seed_baselines)
+        m_seeder.add_baselines();
+
+    if (!m_settings.m_seed_file.empty())
+        m_seeder.add_file(m_settings.m_seed_file);
+
+    m_reporter.set_seed_output(m_settings.m_save_seeds_file);
+    m_reporter.set_timing(m_settings.m_report_timing,m_settings.m_timing_file);
+
+    if (!m_settings.m_trace_file.empty())
+        trace_writer::global().open(m_settings.m_trace_file);
+    
     // pick a fitness scaler based on argument
     scaler< acovea_organism > * chosen_scaler;
     string scaler_name;
@@ -1813,9 +7912,9 @@ acovea_world::acovea_world(acovea_listener & a_listener,
         scaler_code = "na"; // not any
     }
     
-    static const char * MODE_NAME[3] =
+    static const char * MODE_NAME[4] =
     {
-        "speed", "size", "return value"
+        "speed", "size", "return value", "speed and size (Pareto)"
     };
     
     char time_text[100];
@@ -1888,7 +7987,7 @@ acovea_world::acovea_world(acovea_listener & a_listener,
         strcpy(version_text,"not requested");
 
     // display the header        
-    m_config_text << "\n   test application: " << a_bench_name << flush
+    m_config_text << "\n   test application: " << m_suite.get_description() << flush
                   << "\n        test system: " << hostname
                   << "\n config description: " << m_target.get_description()
                   << " (version "              << m_target.get_config_version() << ")"
@@ -1906,11 +8005,158 @@ acovea_world::acovea_world(acovea_listener & a_listener,
                   << "\n generations to run: " << a_generations
                   << "\n random number seed: " << libevocosm::globals::get_seed()
                   << "\n       testing mode: " << MODE_NAME[a_mode]
-                  << "\n\n    test start time: " << time_text
+                  << "\n     fitness metric: " << (((a_mode == OPTIMIZE_SPEED) || (a_mode == OPTIMIZE_PARETO)) ? m_target.get_fitness().get_description() : string("not used"))
+                  << "\n      fitness cache: " << (m_settings.m_use_cache ? m_cache.get_description() : string("disabled"));
+
+    if (m_settings.m_use_surrogate)
+        m_config_text << "\n    surrogate model: screening " << m_settings.m_surrogate_screen << " candidates per child, "
+                      << (m_settings.m_surrogate_explore * 100) << "% exploration";
+    else
+        m_config_text << "\n    surrogate model: disabled";
+
+    if (m_settings.m_polish)
+        m_config_text << "\n    final polishing: " << m_settings.m_repeats << " runs per test, "
+                      << m_tester.jobs() << " test(s) at once, "
+                      << (m_settings.m_polish_threshold * 100) << "% threshold";
+    else
+        m_config_text << "\n    final polishing: disabled";
+
+    m_config_text << "\n    option ablation: " << (m_settings.m_ablation ? "enabled" : "disabled");
+
+    m_config_text << "\n        fork server: " << (m_settings.m_fork_server ? "for repeated runs, if the benchmark supports one" : "disabled");
+
+    if (m_settings.m_verify)
+        m_config_text << "\n       verification: checksum agrees with the baseline's within " << m_settings.m_verify_tolerance;
+    else
+        m_config_text << "\n       verification: disabled";
+
+    if (m_checkpoint.is_enabled())
+    {
+        m_config_text << "\n         checkpoint: " << (m_settings.m_checkpoint_file.empty() ? m_settings.m_resume_file : m_settings.m_checkpoint_file)
+                      << ", every " << m_settings.m_checkpoint_every << " generation(s)";
+
+        if (m_settings.m_checkpoint_minutes > 0.0)
+            m_config_text << " or " << m_settings.m_checkpoint_minutes << " minutes";
+    }
+    else
+        m_config_text << "\n         checkpoint: disabled";
+
+    m_config_text << "\n     adaptive rates: " << m_diversity.get_description();
+
+    m_config_text << "\n     multi-fidelity: " << m_fidelity.get_description();
+
+    if (m_target.has_profile())
+        m_config_text << "\n     profile-guided: " << m_profiles.get_description();
+    else
+        m_config_text << "\n     profile-guided: disabled";
+
+    if (m_target.has_functions())
+    {
+        m_config_text << "\n    tuned functions: ";
+
+        for (size_t f = 0; f < m_target.get_functions().size(); ++f)
+            m_config_text << ((f > 0) ? ", " : "") << m_target.get_functions()[f];
+
+        m_config_text << " (" << (m_target.chromosome_length() - m_target.get_global_option_count()) / m_target.get_functions().size()
+                      << " options each)";
+    }
+    else
+        m_config_text << "\n    tuned functions: none";
+
+    m_config_text << "\n   duplicate filter: " << (m_settings.m_unique_children ? m_filter.get_description() : string("disabled"));
+
+    m_config_text << "\n   population seeds: " << m_seeder.get_description();
+
+    if (!phase_profile::is_enabled())
+        m_config_text << "\n       phase timing: not compiled in";
+    else
+    {
+        m_config_text << "\n       phase timing: " << (m_settings.m_report_timing ? "reported every generation" : "collected");
+
+        if (!m_settings.m_timing_file.empty())
+            m_config_text << ", written to " << m_settings.m_timing_file;
+    }
+
+    if (m_settings.m_trace_file.empty())
+        m_config_text << "\n              trace: disabled";
+    else if (phase_profile::is_enabled())
+        m_config_text << "\n              trace: " << m_settings.m_trace_file;
+    else
+        m_config_text << "\n              trace: " << m_settings.m_trace_file << " (timing not compiled in; no spans)";
+
+    m_config_text << "\n             budget: " << m_budget.get_description();
+
+    if (m_settings.m_steady_state)
+        m_config_text << "\n          evolution: steady-state, " << m_tester.jobs() << " concurrent test(s)";
+    else
+        m_config_text << "\n          evolution: generational";
+
+    if (m_settings.m_island_address.empty())
+        m_config_text << "\n             island: single process";
+    else
+    {
+        m_transport = migrant_transport::create(m_settings.m_island_address,m_settings.m_island_peers);
+        m_island_migrator = new island_migrator(m_migrator,*m_transport,m_target,m_listener,
+                                                size_t(a_population_size * a_migration_rate + 0.5));
+        m_config_text << "\n             island: " << m_transport->get_description();
+    }
+
+    if (!m_settings.m_resume_file.empty())
+        m_config_text << "\n       resumed from: " << m_settings.m_resume_file << " at generation " << m_first_generation;
+
+    m_config_text << "\n\n    test start time: " << time_text
                   << "\n" << endl;
            
     m_listener.report_config(m_config_text.str());
     m_reporter.set_config_text(m_config_text.str());
+    
+    if (m_settings.m_use_cache)
+        m_reporter.set_fitness_cache(&m_cache);
+    
+    if (m_settings.m_use_surrogate)
+    {
+        m_reproducer.set_surrogate(&m_surrogate,m_settings.m_surrogate_screen,m_settings.m_surrogate_explore);
+        m_reporter.set_surrogate(&m_surrogate);
+    }
+
+    // children are mutated as they are bred, so that screening and the
+    //   duplicate filter judge the genomes that are tested; steady-state
+    //   evolution breeds one child at a time, and always does
+    if (m_settings.m_use_surrogate || m_settings.m_unique_children || m_settings.m_steady_state)
+    {
+        m_reproducer.set_mutator(&m_mutator);
+        m_mutator.set_in_breeding(true);
+    }
+    
+    if (m_settings.m_polish)
+        m_reporter.set_polisher(&m_polisher);
+    
+    if (m_settings.m_ablation)
+        m_reporter.set_ablation(&m_ablation);
+    
+    m_reporter.set_diversity(&m_diversity);
+    
+    if (m_settings.m_unique_children)
+    {
+        m_reproducer.set_filter(&m_filter);
+        m_reporter.set_offspring_filter(&m_filter);
+    }
+    
+    if (m_fidelity.is_enabled())
+        m_reporter.set_fidelity(&m_fidelity);
+
+    if (m_target.has_profile())
+    {
+        m_reporter.set_profiles(&m_profiles);
+        m_tester.set_profiles(&m_profiles);
+    }
+    
+    if (m_checkpoint.is_enabled())
+        m_reporter.set_checkpoint(&m_checkpoint,m_first_generation);
+
+    // steady-state runs manage their own populations
+    if (m_settings.m_steady_state)
+        return;
 
     // create evocosm with requested arguments
     m_evocosm = new evocosm<acovea_organism, acovea_landscape> (m_listener,
@@ -1921,7 +8167,9 @@ acovea_world::acovea_world(acovea_listener & a_listener,
                                                                 m_mutator,
                                                                 m_reproducer,
                                                                 *chosen_scaler,
-                                                                m_migrator,
+                                                                (m_island_migrator != NULL)
+                                                                    ? static_cast<migrator<acovea_organism> &>(*m_island_migrator)
+                                                                    : static_cast<migrator<acovea_organism> &>(m_migrator),
                                                                 m_selector,
                                                                 m_reporter,
                                                                 *this,
@@ -1936,31 +8184,178 @@ acovea_organism acovea_world::create()
 
 void acovea_world::append(vector<acovea_organism> & a_population, size_t a_size)
 {
+    // a resumed run continues with its saved populations
+    if (m_checkpoint.restore_population(a_population))
+        return;
+
+    // start with known option lists, if any
+    size_t seeded = m_seeder.seed(a_population,a_size);
+    
     // fill remaining population with random values    
-    for (size_t i = 0; i < a_size; ++i)
+    for (size_t i = seeded; i < a_size; ++i)
         a_population.push_back(acovea_organism(m_target));
 }
 
 acovea_landscape acovea_world::generate()
 {
-    return acovea_landscape(m_input_name,m_mode,m_target,m_listener);
+    return acovea_landscape(m_suite,
+                            m_mode,
+                            m_target,
+                            m_listener,
+                            (m_settings.m_use_cache ? &m_cache : NULL),
+                            (m_settings.m_use_surrogate ? &m_surrogate : NULL),
+                            &m_checkpoint,
+                            (m_fidelity.is_enabled() ? &m_fidelity : NULL),
+                            (m_target.has_profile() ? &m_profiles : NULL));
+}
+
+// test the baselines, returning the best fitness; with several inputs,
+//   each is first normalized to its best baseline. When verifying, the
+//   first baseline to succeed on an input sets its reference checksum.
+double acovea_world::test_baselines()
+{
+    double best = BOGUS_RUN_TIME;
+
+    chromosome empty_options = m_target.get_random_options();
+
+    for (int n = 0; n < empty_options.size(); ++n)
+        empty_options[n]->set_enabled(false);
+
+    vector<command_elements> baselines = m_target.get_baselines();
+    vector< vector<evaluation_record> > records(baselines.size());
+
+    for (int n = 0; n < baselines.size(); ++n)
+    {
+        double fitness = run_suite(m_suite,m_target,&baselines[n],empty_options,m_listener,m_mode,
+                                   NULL,NULL,NULL,1.0,&records[n]);
+
+        if (fitness < best)
+            best = fitness;
+    }
+
+    for (size_t i = 0; i < m_suite.size(); ++i)
+    {
+        double input_best = BOGUS_RUN_TIME;
+
+        for (int n = 0; n < baselines.size(); ++n)
+        {
+            const evaluation_record & record = records[n][i];
+            input_best = min(input_best,record.m_fitness);
+
+            if (!m_settings.m_verify || (record.m_fitness == BOGUS_RUN_TIME))
+                continue;
+
+            // later baselines should agree with the first
+            map<string,string>::const_iterator checksum = record.m_metrics.find("checksum");
+
+            if (m_suite.get_checksum(i).empty() && (checksum != record.m_metrics.end()))
+                m_suite.set_checksum(i,checksum->second);
+            else
+                verify_result(m_suite,i,record.m_metrics,record.m_command,m_listener);
+        }
+
+        if (m_settings.m_verify && m_suite.get_checksum(i).empty())
+            throw runtime_error("no baseline reports a checksum for " + m_suite.get_input(i));
+
+        m_suite.set_baseline(i,input_best);
+    }
+
+    // with several inputs, the baselines are measured against each other
+    if (m_suite.is_combined())
+    {
+        best = BOGUS_RUN_TIME;
+
+        for (int n = 0; n < baselines.size(); ++n)
+        {
+            vector<double> fitness;
+
+            for (size_t i = 0; i < m_suite.size(); ++i)
+                fitness.push_back(records[n][i].m_fitness);
+
+            best = min(best,m_suite.combine(fitness));
+        }
+    }
+
+    m_listener.report(m_suite.get_baseline_text());
+
+    ostringstream text;
+    text << "best baseline fitness: " << best << "\n";
+    m_listener.report(text.str());
+
+    return best;
 }
 
 double acovea_world::run()
 {
+    // each separately tuned function is defined by some input
+    for (size_t f = 0; f < m_target.get_functions().size(); ++f)
+    {
+        bool defined = false;
+
+        for (size_t n = 0; n < m_suite.size(); ++n)
+            defined = defined || m_target.defines_function(m_suite.get_input(n),m_target.get_functions()[f]);
+
+        if (!defined)
+            throw runtime_error("no input defines the function " + m_target.get_functions()[f]);
+    }
+
+    // a target is relative to the best baseline, as are results on each
+    //   of several inputs; verified results are checked against it
+    if (m_budget.needs_baseline() || m_suite.is_combined() || m_settings.m_verify)
+    {
+        double baseline = test_baselines();
+
+        if (m_budget.needs_baseline())
+            m_budget.set_baseline(baseline);
+    }
+
     double fitness = 0.0;
+    size_t batch   = m_number_of_populations * m_population_size;
+    string reason;
+
+    // the budget must have room for at least one generation
+    if (!m_checkpoint.is_replaying() && !m_budget.allows(m_reporter.evaluations(),batch,reason))
+    {
+        ostringstream message;
+        message << reason << " before the first generation of " << batch << " tests";
+        throw runtime_error(message.str());
+    }
+
+    if (m_settings.m_steady_state)
+        return run_steady_state();
 
     // continue for specified number of iterations
-    for (size_t count = 1; count <= m_generations; ++count)
+    for (size_t count = m_first_generation; count <= m_generations; ++count)
     {
+        // this generation is the last if the budget has no room for another
+        bool last = (count == m_generations) || !m_budget.allows(m_reporter.evaluations(),2 * batch,reason);
+
+        if (last && (count < m_generations))
+            m_listener.report("stopping early: " + reason + "\n");
+
         // run a generation
-        bool keep_going =  m_evocosm->run_generation(count == m_generations,fitness);
+        bool keep_going =  m_evocosm->run_generation(last,fitness);
         
         if (!keep_going)
         {
             m_listener.report_error("run aborted\n");
             break;
         }
+
+        if (last)
+            break;
+
+        // the generation's children have been bred
+        m_reporter.end_generation();
+
+        // stop once the target is met or progress stalls, reporting on
+        //   the generation just tested
+        if (m_budget.is_finished(m_reporter.best_fitness(),reason))
+        {
+            m_listener.report("stopping early: " + reason + "\n");
+            m_reporter.finish();
+            break;
+        }
     }
     
     // announce that we're finished
@@ -1969,14 +8364,240 @@ double acovea_world::run()
     return fitness;
 }
             
+// breed and mutate one child from a population
+acovea_organism acovea_world::breed_one(const vector<acovea_organism> & a_population)
+{
+    // parents are chosen by linear rank, so that one outstanding organism
+    //   does not swamp the population between generations
+    vector<acovea_organism> ranked(a_population);
+    sort(ranked.begin(),ranked.end());
+
+    for (size_t n = 0; n < ranked.size(); ++n)
+        ranked[n].fitness() = static_cast<double>(ranked.size() - n);
+
+    // the reproducer mutates the child
+    vector<acovea_organism> children = m_reproducer.breed(ranked,1);
+
+    return children.front();
+}
+
+// steady-state evolution: whenever a test slot is free, a child is bred
+//   from one of the populations and its test started; when the test
+//   finishes, the child replaces the worst organism in its population if
+//   it is no worse. Each population-sized batch of tests is reported as a
+//   generation, and the run performs as many tests as a generational run.
+double acovea_world::run_steady_state()
+{
+    double fitness = 0.0;
+
+    migrator<acovea_organism> & chosen_migrator = (m_island_migrator != NULL)
+                                                ? static_cast<migrator<acovea_organism> &>(*m_island_migrator)
+                                                : static_cast<migrator<acovea_organism> &>(m_migrator);
+
+    // create and test the initial populations
+    vector< vector<acovea_organism> > populations(m_number_of_populations);
+    vector<chromosome> initial;
+
+    for (size_t p = 0; p < m_number_of_populations; ++p)
+    {
+        append(populations[p],m_population_size);
+
+        for (size_t n = 0; n < populations[p].size(); ++n)
+            initial.push_back(populations[p][n].genes());
+    }
+
+    m_listener.ping_generation_begin(1);
+
+    vector<measurement> results = m_tester.measure(initial);
+
+    for (size_t p = 0, i = 0; p < m_number_of_populations; ++p)
+    {
+        for (size_t n = 0; n < populations[p].size(); ++n, ++i)
+        {
+            populations[p][n].fitness() = results[i].m_mean;
+
+            if (m_settings.m_use_surrogate)
+                m_surrogate.train(populations[p][n].genes(),results[i].m_mean);
+        }
+    }
+
+    m_listener.ping_generation_end(1);
+
+    bool keep_going = m_reporter.report(populations,1,fitness,(m_generations <= 1));
+
+    // children are bred as tests finish, so a batch's time is all in hand
+    if (m_generations > 1)
+        m_reporter.end_generation();
+
+    // children being tested, by tag, with the population they belong to
+    map<size_t, pair<size_t, acovea_organism> > pending;
+
+    size_t batch      = m_number_of_populations * m_population_size;
+    size_t total      = (m_generations > 1) ? batch * (m_generations - 1) : 0;
+    size_t started    = 0;
+    size_t finished   = 0;
+    size_t generation = 1;
+    bool   stopping   = false;
+    string reason;
+
+    if (keep_going && (total > 0))
+    {
+        // the budget may already be spent
+        if (m_budget.is_finished(m_reporter.best_fitness(),reason))
+        {
+            m_listener.report("stopping early: " + reason + "\n");
+            m_reporter.finish();
+            total = 0;
+        }
+        else
+        {
+            chosen_migrator.migrate(populations);
+            m_listener.ping_generation_begin(2);
+        }
+    }
+
+    while (keep_going && (finished < total))
+    {
+        if (m_terminated)
+        {
+            keep_going = false;
+            break;
+        }
+
+        // keep every test slot busy
+        while (!stopping && (started < total) && (m_tester.running() < m_tester.jobs()))
+        {
+            if (!m_budget.allows(m_reporter.evaluations() + pending.size(),1,reason))
+            {
+                m_listener.report("stopping early: " + reason + "\n");
+                stopping = true;
+                break;
+            }
+
+            size_t p = started % m_number_of_populations;
+            acovea_organism child = breed_one(populations[p]);
+
+            m_tester.start(child.genes(),started);
+            pending.insert(make_pair(started,make_pair(p,child)));
+            ++started;
+        }
+
+        // once stopping, the tests in progress finish the run as a short generation
+        if (stopping && pending.empty())
+        {
+            if ((finished % batch) == 0)
+                m_reporter.finish();
+            else
+            {
+                ++generation;
+                m_listener.ping_generation_end(generation);
+                keep_going = m_reporter.report(populations,generation,fitness,true);
+            }
+
+            break;
+        }
+
+        // wait for a test to finish
+        size_t tag;
+        measurement result;
+
+        if (!m_tester.collect(tag,result))
+        {
+            m_listener.yield();
+            continue;
+        }
+
+        map<size_t, pair<size_t, acovea_organism> >::iterator entry = pending.find(tag);
+        vector<acovea_organism> & population = populations[entry->second.first];
+        acovea_organism & child = entry->second.second;
+
+        child.fitness() = result.m_mean;
+
+        if (m_settings.m_use_surrogate)
+            m_surrogate.train(child.genes(),child.fitness());
+
+        // replace the worst organism in the child's population
+        size_t worst = 0;
+
+        for (size_t n = 1; n < population.size(); ++n)
+        {
+            if (population[n].fitness() > population[worst].fitness())
+                worst = n;
+        }
+
+        if (child.fitness() <= population[worst].fitness())
+            population[worst] = child;
+
+        pending.erase(entry);
+        ++finished;
+
+        m_listener.ping_fitness_test_end((finished - 1) % batch + 1);
+
+        // a batch of tests stands in for a generation
+        if ((finished % batch) == 0)
+        {
+            ++generation;
+
+            m_listener.ping_generation_end(generation);
+
+            keep_going = m_reporter.report(populations,generation,fitness,(generation == m_generations));
+
+            if (!keep_going || (generation == m_generations))
+                break;
+
+            m_reporter.end_generation();
+
+            if (!stopping && m_budget.is_finished(m_reporter.best_fitness(),reason))
+            {
+                m_listener.report("stopping early: " + reason + "\n");
+                stopping = true;
+            }
+
+            if (stopping && pending.empty())
+            {
+                m_reporter.finish();
+                break;
+            }
+
+            chosen_migrator.migrate(populations);
+            m_listener.ping_generation_begin(generation + 1);
+        }
+    }
+
+    // don't leave tests running behind us
+    while (m_tester.running() > 0)
+    {
+        size_t tag;
+        measurement result;
+
+        if (!m_tester.collect(tag,result))
+            m_listener.yield();
+    }
+
+    if (!keep_going)
+        m_listener.report_error("run aborted\n");
+
+    // announce that we're finished
+    m_listener.run_complete();
+
+    return fitness;
+}
+
 // terminate run
 void acovea_world::terminate()
 {
-    m_evocosm->terminate();
+    m_terminated = true;
+
+    if (m_evocosm != NULL)
+        m_evocosm->terminate();
 }
 
 acovea_world::~acovea_world()
 {
     delete m_evocosm;
+    delete m_island_migrator;
+    delete m_transport;
+
+    trace_writer::global().close();
 }
 
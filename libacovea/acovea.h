@@ -40,6 +40,13 @@
 #include "libevocosm/evocosm.h"
 #include "libevocosm/roulette.h"
 
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <cstdio>
+
 namespace acovea
 {
     using namespace libevocosm;
@@ -52,6 +59,149 @@ namespace acovea
         OPTIMIZE_SPEED,
         OPTIMIZE_SIZE,
         OPTIMIZE_RETVAL,
+        OPTIMIZE_PARETO     // speed and size together (multi-objective)
+    };
+
+    // fitness assigned to an option set whose test failed
+    const double BOGUS_RUN_TIME = 1000000000.0;
+
+    //----------------------------------------------------------
+    // settings for an ACOVEA run that go beyond the classic evolutionary
+    //   parameters; defaults reproduce the traditional behavior
+    struct run_settings
+    {
+        // constructor (sets defaults)
+        run_settings();
+
+        // reuse measurements of byte-identical binaries
+        bool   m_use_cache;
+
+        // fingerprint only loaded, non-note sections (ignores build IDs etc.)
+        bool   m_cache_code_only;
+
+        // number of samples to collect for a binary before reusing its mean
+        size_t m_cache_refine;
+
+        // pre-screen offspring with a surrogate fitness model
+        bool   m_use_surrogate;
+
+        // candidates bred per child actually tested
+        size_t m_surrogate_screen;
+
+        // fraction of children chosen at random from the screened candidates
+        double m_surrogate_explore;
+
+        // number of option sets tested at once outside the generational loop
+        size_t m_jobs;
+
+        // number of runs per option set for repeated measurements
+        size_t m_repeats;
+
+        // run repeated measurements through a fork server, for benchmarks
+        //   that support one
+        bool   m_fork_server;
+
+        // screen each generation at workloads scaled down to this fraction,
+        //   promoting the best of each rung to a larger one (0 for none)
+        double m_fidelity_scale;
+
+        // fraction of each rung promoted to the next
+        double m_fidelity_promote;
+
+        // reject option sets whose benchmark reports a different checksum
+        //   than a baseline build
+        bool   m_verify;
+
+        // relative difference allowed between checksums that are numbers
+        double m_verify_tolerance;
+
+        // hill-climb from the best organism after the final generation
+        bool   m_polish;
+
+        // measure the effect of each option on the final result
+        bool   m_ablation;
+
+        // file receiving periodic checkpoints (empty for none)
+        string m_checkpoint_file;
+
+        // generations between checkpoints
+        size_t m_checkpoint_every;
+
+        // minutes between checkpoints (zero for no time limit)
+        double m_checkpoint_minutes;
+
+        // checkpoint to resume from (empty to start a new run)
+        string m_resume_file;
+
+        // address of this process's island (empty for a single process run)
+        string m_island_address;
+
+        // addresses of the other islands
+        vector<string> m_island_peers;
+
+        // breed and test one organism whenever a test slot frees up,
+        //   instead of a whole generation at a time
+        bool m_steady_state;
+
+        // most fitness tests to perform (0 for no limit)
+        size_t m_max_evaluations;
+
+        // most wall-clock minutes to run (0 for no limit)
+        double m_max_minutes;
+
+        // stop on reaching this fraction of the best baseline's fitness (0 for none)
+        double m_target_ratio;
+
+        // stop when the best fitness improves by no more than m_stall_epsilon
+        //   (relative) for this many generations (0 for never)
+        size_t m_stall_generations;
+        double m_stall_epsilon;
+
+        // fraction of the test and time limits held back for the final report
+        double m_budget_reserve;
+
+        // adjust mutation and crossover rates to hold population diversity
+        //   (mean distance between genomes) between these bounds
+        bool   m_adaptive_rates;
+        double m_diversity_low;
+        double m_diversity_high;
+
+        // breed again or mutate children that repeat a genome in their
+        //   population (and, optionally, any genome tested before)
+        bool   m_unique_children;
+        bool   m_unique_history;
+        size_t m_unique_retries;
+
+        // seed initial populations from the configuration's baselines
+        bool m_seed_baselines;
+
+        // seed initial populations from a file of option lists, each line
+        //   an optional fitness followed by options (empty for none)
+        string m_seed_file;
+
+        // share of each initial population taken from seeds
+        double m_seed_fraction;
+
+        // mutation applied to repeated seeds
+        double m_seed_mutation;
+
+        // file receiving the final populations, in seed file format
+        string m_save_seeds_file;
+
+        // report phase timing every generation and at the end of the run
+        bool   m_report_timing;
+
+        // file receiving the phase timing histograms
+        string m_timing_file;
+
+        // file receiving a Chrome trace-event timeline of the run
+        string m_trace_file;
+
+        // maximum number of improvement passes while polishing
+        size_t m_polish_passes;
+
+        // smallest relative change in fitness considered real
+        double m_polish_threshold;
     };
 
     //----------------------------------------------------------
@@ -266,6 +416,17 @@ namespace acovea
                 return m_value;
             }
 
+            // get the range of values
+            int get_min_value() const
+            {
+                return m_min_value;
+            }
+
+            int get_max_value() const
+            {
+                return m_max_value;
+            }
+
             // get the value of this option
             int set_value(int a_value) 
             {
@@ -276,6 +437,14 @@ namespace acovea
                 
                 if (m_value > m_max_value)
                     m_value = m_max_value;
+
+                return m_value;
+            }
+
+            // get the change in value per mutation
+            int get_step() const
+            {
+                return m_step;
             }
 
             // get the value of this option
@@ -284,6 +453,12 @@ namespace acovea
                 return m_default;
             }
 
+            // get the separator between name and value
+            char get_separator() const
+            {
+                return m_separator;
+            }
+
             // averaging
             virtual bool has_settings()
             {
@@ -355,6 +530,13 @@ namespace acovea
                 return m_setting;
             }
 
+            // change the current setting
+            void set_setting(int a_setting)
+            {
+                if ((a_setting >= 0) && (a_setting < static_cast<int>(m_choices.size())))
+                    m_setting = a_setting;
+            }
+
             // randomize settings of this option
             virtual void randomize();
 
@@ -421,6 +603,151 @@ namespace acovea
         string m_flags;
     } command_elements;
 
+    //----------------------------------------------------------
+    // the result a benchmark writes to standard output
+    //
+    //   version 0: the first line begins with a number, the run time;
+    //   key=value fields may follow it on the same line
+    //
+    //   version 1: a line "acovea-result/1 key=value key=value ..." that
+    //   can appear anywhere in the output; the last one counts
+    //
+    //   a leading bare number is reported as the metric "time"
+    class benchmark_result
+    {
+        public:
+            // constructor
+            benchmark_result();
+
+            // read the output of a benchmark; returns false if it holds no
+            //   result, or one in an unknown version
+            bool parse(const string & a_output);
+
+            // get a numeric field; returns false if absent or not a number
+            bool get_metric(const string & a_name, double & a_value) const;
+
+            // all fields, as reported
+            const map<string,string> & get_fields() const
+            {
+                return m_fields;
+            }
+
+            // protocol version of the parsed result
+            int get_version() const
+            {
+                return m_version;
+            }
+
+        private:
+            // read key=value fields from a line
+            void parse_fields(const string & a_line, size_t a_start);
+
+            map<string,string> m_fields;
+            int m_version;
+    };
+
+    //----------------------------------------------------------
+    // fitness computed from benchmark metrics, as a weighted sum; lower
+    //   is better, so a metric where more is better (throughput) enters
+    //   as its reciprocal, named "1/metric"
+    class fitness_formula
+    {
+        public:
+            // constructor; fitness is the metric "time"
+            fitness_formula();
+
+            // constructor from text, as in "median" or "min:1,max:0.25"
+            fitness_formula(const string & a_text);
+
+            // add a metric with a positive weight; the first replaces the default
+            void add_term(const string & a_metric, double a_weight);
+
+            // compute fitness; returns false, with the name of the missing
+            //   metric, if the result doesn't report one that is used
+            bool evaluate(const benchmark_result & a_result,
+                          double & a_fitness,
+                          string & a_missing) const;
+
+            // description for the configuration report
+            string get_description() const;
+
+        private:
+            vector< pair<string,double> > m_terms;
+            bool m_default;
+    };
+
+    //----------------------------------------------------------
+    // the benchmark programs an option set is tested on; with several,
+    //   fitness on each is normalized to its best baseline and combined
+    //   by a weighted geometric mean. Results can be checked against a
+    //   checksum reported by a baseline build.
+    class benchmark_suite
+    {
+        public:
+            // constructor from text, as in "huffbench.c" or
+            //   "almabench.c:1,huffbench.c:2"
+            benchmark_suite(const string & a_text);
+
+            // number of inputs
+            size_t size() const
+            {
+                return m_inputs.size();
+            }
+
+            // are results on several inputs combined?
+            bool is_combined() const
+            {
+                return m_inputs.size() > 1;
+            }
+
+            // name of an input
+            const string & get_input(size_t a_index) const
+            {
+                return m_inputs[a_index];
+            }
+
+            // weight of an input
+            double get_weight(size_t a_index) const
+            {
+                return m_weights[a_index];
+            }
+
+            // set the fitness an input is normalized to
+            void set_baseline(size_t a_index, double a_fitness);
+
+            // combine fitness on each input; a failure on any input fails
+            double combine(const vector<double> & a_fitness) const;
+
+            // description for the configuration report
+            string get_description() const;
+
+            // set the relative difference allowed between checksums that
+            //   are numbers
+            void set_tolerance(double a_tolerance);
+
+            // set the checksum results on an input must agree with
+            void set_checksum(size_t a_index, const string & a_checksum);
+
+            // checksum results on an input must agree with (empty if none)
+            const string & get_checksum(size_t a_index) const
+            {
+                return m_checksums[a_index];
+            }
+
+            // do the fields of a result agree with an input's checksum?
+            bool verify(size_t a_index, const map<string,string> & a_fields) const;
+
+            // baselines and checksums, as text
+            string get_baseline_text() const;
+
+        private:
+            vector<string> m_inputs;
+            vector<double> m_weights;
+            vector<double> m_baselines;
+            vector<string> m_checksums;
+            double m_tolerance;
+    };
+
     class application : public common
     {
         public:
@@ -474,18 +801,92 @@ namespace acovea
             
             // get the get version command
             vector<string> get_get_app_version() const;
-        
+
+            // get the metrics that make up fitness
+            const fitness_formula & get_fitness() const;
+
+            // set the metrics that make up fitness
+            void set_fitness(const fitness_formula & a_fitness);
+
             // return an execv-compatible argument list for compiling a given program
             vector<string> get_prime_command(const string &     a_input_name,
                                              const string &     a_output_name,
-                                             const chromosome & a_options) const;
+                                             const chromosome & a_options,
+                                             const string &     a_profile_dir = string()) const;
             
-            // return an execv-compatible argument list for compiling a given program
+            // return an execv-compatible argument list for compiling a given program;
+            //   ACOVEA_PROFILE in the flags names the profile directory
             vector<string> get_command(const command_elements & a_elements,
                                        const string &     a_input_name,
                                        const string &     a_output_name,
-                                       const chromosome & a_options) const;
-            
+                                       const chromosome & a_options,
+                                       const string &     a_profile_dir = string()) const;
+
+            // are programs built in two phases, with a training run of an
+            //   instrumented build?
+            bool has_profile() const
+            {
+                return !m_profile.m_command.empty();
+            }
+
+            // return an argument list for an instrumented build, with only
+            //   the options that affect instrumentation
+            vector<string> get_profile_command(const string &     a_input_name,
+                                               const string &     a_output_name,
+                                               const chromosome & a_options,
+                                               const string &     a_profile_dir) const;
+
+            // the options that affect instrumentation, as text
+            string get_profile_key(const chromosome & a_options) const;
+
+            // workload scale of a training run
+            double get_profile_scale() const
+            {
+                return m_profile_scale;
+            }
+
+            // number of options that affect instrumentation
+            size_t get_profile_option_count() const
+            {
+                return m_profile_options.size();
+            }
+
+            // tune functions separately: each gets its own copy of the options
+            //   that can be set per function, after the options for the whole
+            //   program, and compiles them into pragmas around its definition
+            void set_functions(const vector<string> & a_functions);
+
+            // are functions tuned separately?
+            bool has_functions() const
+            {
+                return !m_functions.empty();
+            }
+
+            // names of the functions tuned separately
+            const vector<string> & get_functions() const
+            {
+                return m_functions;
+            }
+
+            // number of options for the whole program
+            size_t get_global_option_count() const
+            {
+                return m_options.size() - m_functions.size() * m_function_options.size();
+            }
+
+            // enabled options of a tuned function, as flags
+            string get_function_flags(const chromosome & a_options, size_t a_function) const;
+
+            // an option's text for reports, naming its function if it has one
+            string get_option_label(size_t a_index, const string & a_text) const;
+
+            // does an input define a function?
+            bool defines_function(const string & a_input_name, const string & a_function) const;
+
+            // source of an input with each tuned function's options in pragmas
+            //   around its definition; empty if the input can't be read
+            string get_function_source(const string & a_input_name, const chromosome & a_options) const;
+
             // get a random set of options for this application
             chromosome get_random_options() const;
             
@@ -512,6 +913,13 @@ namespace acovea
             vector<command_elements> m_baselines; // baselines for comparison with evolved solution
             chromosome       m_options;	          // the base list of options/flags
             bool             m_quoted_options;    // should options be handled in quotes?
+            fitness_formula  m_fitness;           // benchmark metrics that make up fitness
+            command_elements m_profile;           // instrumented build (empty if none)
+            double           m_profile_scale;     // workload scale of a training run
+            vector<size_t>   m_profile_options;   // indices of options that affect instrumentation
+            vector<string>   m_functions;         // functions tuned separately
+            vector<size_t>   m_function_options;  // indices of options that can be set per function
+            string           m_config_error;      // first invalid setting found while parsing
     };
     
     //----------------------------------------------------------
@@ -548,6 +956,209 @@ namespace acovea
             {
                 return (m_fitness < a_right.fitness());
             }
+
+            // measured run time (multi-objective mode)
+            double run_time() const
+            {
+                return m_run_time;
+            }
+
+            double & run_time()
+            {
+                return m_run_time;
+            }
+
+            // measured program size (multi-objective mode)
+            double code_size() const
+            {
+                return m_code_size;
+            }
+
+            double & code_size()
+            {
+                return m_code_size;
+            }
+
+            // does this organism dominate another in both objectives?
+            bool dominates(const acovea_organism & a_other) const
+            {
+                return (m_run_time <= a_other.m_run_time) && (m_code_size <= a_other.m_code_size)
+                    && ((m_run_time < a_other.m_run_time) || (m_code_size < a_other.m_code_size));
+            }
+
+        private:
+            // objectives behind a Pareto-ranked fitness
+            double m_run_time;
+            double m_code_size;
+    };
+
+    //----------------------------------------------------------
+    // surrogate fitness model
+    //      a linear model over option settings, trained online by recursive
+    //      least squares on every measured organism; it predicts fitness so
+    //      that offspring can be screened before anything is compiled
+    class surrogate_model
+    {
+        public:
+            // creation constructor
+            surrogate_model(const application & a_target);
+
+            // predict the fitness of a set of options
+            double predict(const chromosome & a_genes) const;
+
+            // add a measured organism to the model
+            void train(const chromosome & a_genes, double a_fitness);
+
+            // has the model seen enough organisms to be useful?
+            bool is_trained() const
+            {
+                return m_samples >= m_features;
+            }
+
+            // prediction error for the current generation
+            string get_stats_text() const;
+
+            // begin measuring error for a new generation
+            void reset_generation_stats();
+
+            // write or read the model to or from a checkpoint
+            void save(FILE * a_file) const;
+            void load(FILE * a_file);
+
+        private:
+            // convert options into a feature vector
+            vector<double> encode(const chromosome & a_genes) const;
+
+            // number of features, including the bias term
+            size_t m_features;
+
+            // model coefficients
+            vector<double> m_weights;
+
+            // inverse covariance estimate (m_features x m_features, by row)
+            vector<double> m_covariance;
+
+            // number of organisms trained
+            size_t m_samples;
+
+            // accumulated relative error of predictions made before training
+            double m_gen_error;
+            size_t m_gen_count;
+    };
+
+    //----------------------------------------------------------
+    // multi-fidelity schedule
+    //      successive halving: each generation is tested with scaled-down
+    //      benchmark workloads, and the best fraction of each rung moves on
+    //      to a larger workload; only the last rung runs at full scale
+    class fidelity_schedule : protected common
+    {
+        public:
+            // creation constructor; rungs are spaced geometrically from the
+            //   smallest scale up to full scale
+            fidelity_schedule(double a_min_scale, double a_promote);
+
+            // are workloads scaled at all?
+            bool is_enabled() const
+            {
+                return m_scales.size() > 1;
+            }
+
+            // workload scale of each rung, ending at full scale
+            const vector<double> & get_scales() const
+            {
+                return m_scales;
+            }
+
+            // number of a rung's tests that move on to the next rung
+            size_t promoted(size_t a_tested) const;
+
+            // count the tests run at a rung
+            void count(size_t a_rung, size_t a_tests);
+
+            // description for the configuration report
+            string get_description() const;
+
+            // tests per rung for the current generation
+            string get_stats_text() const;
+
+            // begin counting a new generation
+            void reset_generation_stats();
+
+        private:
+            vector<double> m_scales;
+            double m_promote;
+
+            // tests at each rung this generation
+            vector<size_t> m_gen_tests;
+    };
+
+    //----------------------------------------------------------
+    // offspring filter
+    //      keeps breeding from spending tests on genomes already in the
+    //      population (or, optionally, ever tested): a duplicate child is
+    //      bred again from new parents and then mutated, each a limited
+    //      number of times
+    class offspring_filter : protected common
+    {
+        public:
+            // creation constructor
+            offspring_filter(bool a_use_history, size_t a_retries);
+
+            // hash of a genome, ignoring the settings of disabled options
+            static uint64_t canonical_hash(const chromosome & a_genes);
+
+            // the population children are bred from; its genomes join the history
+            void set_population(const vector<acovea_organism> & a_population);
+
+            // is a genome unknown to the filter?
+            bool is_new(const chromosome & a_genes) const;
+
+            // times a duplicate is bred again, and then mutated
+            size_t retries() const
+            {
+                return m_retries;
+            }
+
+            // count a child bred again
+            void note_redraw()
+            {
+                ++m_redrawn;
+            }
+
+            // add a child to the population, mutating it first if it is a duplicate
+            void accept(chromosome & a_genes);
+
+            // statistics for the last generation and the whole run
+            string get_stats_text() const;
+
+            // begin counting a new generation
+            void reset_generation_stats();
+
+            // description for configuration reports
+            string get_description() const;
+
+            // save and restore the history
+            void save(FILE * a_file) const;
+            void load(FILE * a_file);
+
+        private:
+            // remember every genome tested?
+            bool m_use_history;
+
+            // attempts at a new genome
+            size_t m_retries;
+
+            // genomes in the current population and among its children
+            set<uint64_t> m_current;
+
+            // every genome tested in the run
+            set<uint64_t> m_history;
+
+            // per-generation counts of duplicates bred again, mutated, and kept
+            size_t m_redrawn;
+            size_t m_mutated;
+            size_t m_kept;
     };
 
     //----------------------------------------------------------
@@ -567,19 +1178,35 @@ namespace acovea
             // destructor
             virtual ~acovea_mutator();
 
-            // mutation operation
+            // mutation operation; does nothing when children are mutated
+            //   as they are bred
             virtual void mutate(vector< acovea_organism > & a_population);
 
+            // mutate one child as it is bred
+            void mutate_child(chromosome & a_genes);
+
+            // leave mutation to the reproducer
+            void set_in_breeding(bool a_in_breeding)
+            {
+                m_in_breeding = a_in_breeding;
+            }
+
             // interrogator
             double mutation_rate() const
             {
                 return m_mutation_rate;
             }
 
+            // change the mutation rate
+            void set_mutation_rate(double a_mutation_rate);
+
         private:
             // probability that a mutation will take place (while rand < rate, mutate)
             double m_mutation_rate;
 
+            // are children mutated by the reproducer?
+            bool m_in_breeding;
+
             // application object that is target of this test
             const application & m_target;
     };
@@ -607,128 +1234,1512 @@ namespace acovea
                 return m_crossover_rate;
             }
 
+            // change the crossover rate
+            void set_crossover_rate(double a_crossover_rate);
+
             // reproduction operation
             virtual vector< acovea_organism > breed(const vector< acovea_organism > & a_population,
                                                     size_t a_limit);
 
+            // screen offspring with a surrogate model
+            void set_surrogate(surrogate_model * a_surrogate, size_t a_screen_factor, double a_exploration)
+            {
+                m_surrogate     = a_surrogate;
+                m_screen_factor = a_screen_factor;
+                m_exploration   = a_exploration;
+            }
+
+            // reject duplicate offspring
+            void set_filter(offspring_filter * a_filter)
+            {
+                m_filter = a_filter;
+            }
+
+            // mutate children as they are bred, so that screening sees
+            //   the genomes that will be tested
+            void set_mutator(acovea_mutator * a_mutator)
+            {
+                m_mutator = a_mutator;
+            }
+
         private:
             // probablity of crossover occuring during reporduction
             double m_crossover_rate;
 
+            // surrogate model used to screen candidates (NULL if disabled)
+            surrogate_model * m_surrogate;
+
+            // candidates bred per child returned
+            size_t m_screen_factor;
+
+            // fraction of children picked at random from the candidates
+            double m_exploration;
+
+            // filter for duplicate children (NULL if disabled)
+            offspring_filter * m_filter;
+
+            // mutator applied to each child (NULL to leave it to the evocosm)
+            acovea_mutator * m_mutator;
+
+            // application object that is target of this test
+            const application & m_target;
+    };
+
+    //----------------------------------------------------------
+    // population diversity, averaged over populations; both measures run
+    //   from 0 (every organism alike) to 1
+    typedef struct diversity
+    {
+        double m_entropy;   // mean normalized entropy of each option's settings
+        double m_distance;  // mean fraction of options on which two organisms differ
+    } diversity;
+
+    //----------------------------------------------------------
+    // diversity controller
+    //      measures diversity each generation and, if adaptive, raises the
+    //      mutation rate and lowers the crossover rate while diversity is
+    //      below its band, and does the opposite while it is above
+    class diversity_controller
+    {
+        public:
+            // creation constructor
+            diversity_controller(acovea_mutator &    a_mutator,
+                                 acovea_reproducer & a_reproducer,
+                                 bool                a_adaptive,
+                                 double              a_low,
+                                 double              a_high);
+
+            // measure the diversity of a set of populations
+            static diversity measure(const vector< vector<acovea_organism> > & a_populations);
+
+            // measure diversity after a generation, adjusting rates if requested
+            diversity update(const vector< vector<acovea_organism> > & a_populations, bool a_adjust);
+
+            // current rates
+            double mutation_rate() const
+            {
+                return m_mutator.mutation_rate();
+            }
+
+            double crossover_rate() const
+            {
+                return m_reproducer.crossover_rate();
+            }
+
+            // description for configuration reports
+            string get_description() const;
+
+            // save and restore the adjusted rates
+            void save(FILE * a_file) const;
+            void load(FILE * a_file);
+
+        private:
+            // operators whose rates are controlled
+            acovea_mutator &    m_mutator;
+            acovea_reproducer & m_reproducer;
+
+            // is the controller adjusting rates?
+            bool m_adaptive;
+
+            // target band for mean distance
+            double m_low;
+            double m_high;
+
+            // rates given on the command line, which bound the adjustments
+            double m_base_mutation;
+            double m_base_crossover;
+    };
+
+    //----------------------------------------------------------
+    // phases of a run that are timed, unless ACOVEA_NO_TIMING is defined;
+    //   phases nest (a test includes its compile, which includes a fork),
+    //   so their totals overlap
+    enum run_phase
+    {
+        PHASE_TEST,         // testing one organism
+        PHASE_FORK,         // starting a compiler or benchmark process
+        PHASE_COMPILE,      // compiling a program
+        PHASE_RUN,          // running a benchmark
+        PHASE_FILE_IO,      // temporary names, program sizes and removal
+        PHASE_CACHE,        // fingerprinting a program and looking it up
+        PHASE_YIELD,        // listener yields while waiting for a process
+        PHASE_BREED,        // breeding children
+        PHASE_MUTATE,       // mutating children
+        PHASE_REPORT,       // per-generation statistics
+        PHASE_COUNT
+    };
+
+    //----------------------------------------------------------
+    // latency histogram
+    //      HDR-style: nanosecond values are counted in 16 linear buckets per
+    //      power of two, so percentiles are within about 6% of the true
+    //      value over the whole range, in a fixed amount of memory
+    class latency_histogram
+    {
+        public:
+            // constructor
+            latency_histogram();
+
+            // count a value
+            void record(uint64_t a_nanoseconds)
+            {
+                ++m_counts[bucket(a_nanoseconds)];
+                ++m_count;
+                m_total += a_nanoseconds;
+
+                if (a_nanoseconds < m_min)
+                    m_min = a_nanoseconds;
+
+                if (a_nanoseconds > m_max)
+                    m_max = a_nanoseconds;
+            }
+
+            // add the counts of another histogram
+            void add(const latency_histogram & a_source);
+
+            // forget all values
+            void reset();
+
+            // interrogators
+            uint64_t count() const
+            {
+                return m_count;
+            }
+
+            uint64_t total() const
+            {
+                return m_total;
+            }
+
+            uint64_t min() const
+            {
+                return (m_count > 0) ? m_min : 0;
+            }
+
+            uint64_t max() const
+            {
+                return m_max;
+            }
+
+            // value below which the given percentage of values fall
+            uint64_t percentile(double a_percent) const;
+
+            // write non-empty buckets, one "prefix low high count" line each
+            void write_buckets(FILE * a_file, const char * a_prefix) const;
+
+        private:
+            // sub-buckets per power of two, and buckets in all
+            static const int SUB_BUCKETS = 16;
+            static const int BUCKETS     = 61 * SUB_BUCKETS;
+
+            // bucket holding a value, and the range of a bucket
+            static int bucket(uint64_t a_value)
+            {
+                if (a_value < SUB_BUCKETS)
+                    return static_cast<int>(a_value);
+
+                int exponent = 63 - __builtin_clzll(a_value);
+                return (exponent - 3) * SUB_BUCKETS + static_cast<int>((a_value >> (exponent - 4)) & (SUB_BUCKETS - 1));
+            }
+
+            static uint64_t bucket_low(int a_bucket);
+            static uint64_t bucket_high(int a_bucket);
+
+            // counts and summary values
+            uint64_t m_counts[BUCKETS];
+            uint64_t m_count;
+            uint64_t m_total;
+            uint64_t m_min;
+            uint64_t m_max;
+    };
+
+    //----------------------------------------------------------
+    // phase profile
+    //      latency histograms for each phase of the run, for the current
+    //      generation and for the run as a whole; one profile is shared by
+    //      everything in a process
+    class phase_profile
+    {
+        public:
+            // the profile for this process
+            static phase_profile & global();
+
+            // monotonic time, in nanoseconds
+            static uint64_t now();
+
+            // name of a phase
+            static const char * get_name(run_phase a_phase);
+
+            // is timing compiled in?
+            static bool is_enabled();
+
+            // count the duration of a phase
+            void record(run_phase a_phase, uint64_t a_nanoseconds)
+            {
+                m_generation[a_phase].record(a_nanoseconds);
+            }
+
+            // fold the current generation into the run totals
+            void end_generation();
+
+            // table of counts, percentiles and totals for the current
+            //   generation or the whole run
+            string get_stats_text(bool a_whole_run) const;
+
+            // write the run's summary and histograms to a file
+            void write(const string & a_file_name) const;
+
+        private:
+            // constructor (one per process)
+            phase_profile();
+
+            // histograms for the generation and the completed generations
+            latency_histogram m_generation[PHASE_COUNT];
+            latency_histogram m_run[PHASE_COUNT];
+    };
+
+    //----------------------------------------------------------
+    // a timed phase on the trace timeline
+    typedef struct trace_span
+    {
+        run_phase m_phase;
+        uint64_t  m_start;      // monotonic nanoseconds
+        uint64_t  m_end;
+        size_t    m_test;       // test number (zero outside a test)
+        uint64_t  m_genome;     // canonical hash of the options tested
+    } trace_span;
+
+    //----------------------------------------------------------
+    // trace writer
+    //      streams timed phases as Chrome trace events (loadable by Perfetto
+    //      and chrome://tracing), one lane for the main process and one for
+    //      each parallel test slot; spans in forked test processes are kept
+    //      and sent to the parent with the test's result
+    class trace_writer
+    {
+        public:
+            // the writer for this process
+            static trace_writer & global();
+
+            // start and finish a trace
+            void open(const string & a_file_name);
+            void close();
+
+            // is a trace being written?
+            bool is_open() const
+            {
+                return m_file != NULL;
+            }
+
+            // start and end a test, which labels the spans inside it;
+            //   returns the test number
+            size_t begin_test(const chromosome & a_genes);
+            void end_test();
+
+            // in a forked test process, keep spans for the parent
+            void begin_child();
+
+            // add a span on the main lane, or keep it in a test process
+            void span(run_phase a_phase, uint64_t a_start, uint64_t a_end);
+
+            // spans kept in a test process
+            const vector<trace_span> & kept_spans() const
+            {
+                return m_kept;
+            }
+
+            // write spans from a test process on the lane of its slot
+            void add_spans(const vector<trace_span> & a_spans, size_t a_lane);
+
+            // write a span for a whole test on the lane of its slot
+            void add_test(size_t a_test, uint64_t a_start, uint64_t a_end, size_t a_lane);
+
+        private:
+            // constructor (one per process)
+            trace_writer();
+
+            // write one complete event, naming its lane first if needed
+            void write_event(const char * a_name, const trace_span & a_span, size_t a_lane);
+
+            // output, and the time and process the trace is relative to
+            FILE *   m_file;
+            uint64_t m_origin;
+            pid_t    m_pid;
+
+            // lanes with names, and the number of the last test begun
+            set<size_t> m_named_lanes;
+            size_t   m_tests;
+
+            // the test in progress, if any
+            size_t   m_test;
+            uint64_t m_genome;
+
+            // in a test process, spans kept for the parent
+            bool               m_keeping;
+            vector<trace_span> m_kept;
+    };
+
+    //----------------------------------------------------------
+    // phase timer
+    //      records the time from its creation to its destruction, or to an
+    //      explicit stop, in the process's phase profile and trace
+    class phase_timer
+    {
+        public:
+            // start timing
+            phase_timer(run_phase a_phase)
+              : m_phase(a_phase),
+                m_start(phase_profile::now()),
+                m_running(true)
+            {
+                // nada
+            }
+
+            // stop timing, if still running
+            ~phase_timer()
+            {
+                stop();
+            }
+
+            // record the time so far
+            void stop()
+            {
+                if (m_running)
+                {
+                    uint64_t end = phase_profile::now();
+                    phase_profile::global().record(m_phase,end - m_start);
+
+                    if (trace_writer::global().is_open())
+                        trace_writer::global().span(m_phase,m_start,end);
+
+                    m_running = false;
+                }
+            }
+
+        private:
+            run_phase m_phase;
+            uint64_t  m_start;
+            bool      m_running;
+    };
+
+    // instrumentation that compiles to nothing when ACOVEA_NO_TIMING is defined
+#if defined(ACOVEA_NO_TIMING)
+#define ACOVEA_TIME_PHASE(timer,phase)
+#define ACOVEA_STOP_PHASE(timer)
+#else
+#define ACOVEA_TIME_PHASE(timer,phase) acovea::phase_timer timer(phase)
+#define ACOVEA_STOP_PHASE(timer) timer.stop()
+#endif
+
+    //----------------------------------------------------------
+    // an object that watches acovea world events
+    typedef struct input_result
+    {
+        string  m_input;
+        double  m_fitness;
+    } input_result;
+
+    typedef struct test_result
+    {
+        string  m_description;
+        string  m_detail;
+        double  m_fitness;
+        bool    m_acovea_generated;
+        double  m_code_size;        // zero unless measured (multi-objective mode)
+        vector<input_result> m_inputs;  // empty unless several inputs are combined
+        vector< pair<string,string> > m_functions;  // options of each tuned function
+    } test_result;
+    
+    typedef struct option_zscore
+    {
+        string  m_name;
+        double  m_zscore;
+    } option_zscore;
+    
+    typedef struct option_impact
+    {
+        string  m_name;         // option as it appears on the command line
+        bool    m_removed;      // removed from the best options (or added to them)
+        double  m_delta;        // change in fitness, as a percentage
+        double  m_confidence;   // 95% confidence half-width, as a percentage
+    } option_impact;
+
+    typedef struct evaluation_record
+    {
+        string          m_options;          // enabled options, as command-line flags
+        string          m_command;          // compile command
+        bool            m_compiled;         // did the compiler succeed?
+        int             m_exit_status;      // wait status of the last compile or run
+        double          m_compile_seconds;  // wall-clock time to compile
+        vector<double>  m_run_seconds;      // wall-clock time of each run
+        vector<double>  m_samples;          // fitness reported by each run
+        map<string,string> m_metrics;       // fields of the last benchmark result
+        double          m_scale;            // workload scale (1 for full)
+        size_t          m_inputs;           // inputs the record covers
+        bool            m_cache_hit;        // fitness came from the binary cache
+        double          m_fitness;          // fitness assigned to the option set
+    } evaluation_record;
+    
+    class acovea_listener : public libevocosm::listener
+    {
+        public:
+            // send configuration
+            virtual void report_config(const string & a_text) = 0;
+        
+            // send generation report (every generation)
+            virtual void report_generation(size_t a_gen_no, double a_avg_fitness) = 0;
+        
+            // send final report
+            virtual void report_final(vector<test_result> & a_results,
+                                      vector<option_zscore> & a_zscores,
+                                      vector<option_impact> & a_impacts) = 0;
+
+            // send population diversity and operator rates (every generation)
+            virtual void report_diversity(size_t a_gen_no,
+                                          const diversity & a_diversity,
+                                          double a_mutation_rate,
+                                          double a_crossover_rate);
+
+            // send the details of one compile-and-run test
+            virtual void report_evaluation(const evaluation_record & a_record);
+    };
+    
+    class acovea_listener_stdout : public acovea_listener
+    {
+        public:
+            // ping that a generation begins
+            virtual void ping_generation_begin(size_t a_generation_number);
+        
+            // ping that a generation begins
+            virtual void ping_generation_end(size_t a_generation_number);
+        
+            // ping that a population begins
+            virtual void ping_population_begin(size_t a_population_number);
+            
+            // ping that a population begins
+            virtual void ping_population_end(size_t a_population_number);
+            
+            // ping that a fitness test begins
+            virtual void ping_fitness_test_begin(size_t a_organism_number);
+            
+            // ping that a fitness test begins
+            virtual void ping_fitness_test_end(size_t a_organism_number);
+            
+            // send text
+            virtual void report(const string & a_text);
+            
+            // send error message
+            virtual void report_error(const string & a_text);
+            
+            // acovea is finished
+            virtual void run_complete();
+            
+            // yield
+            virtual void yield();
+            
+            // send configuration
+            virtual void report_config(const string & a_text);
+            
+            // send generation report (every generation)
+            virtual void report_generation(size_t a_gen_no, double a_avg_fitness);
+            
+            // send final report
+            virtual void report_final(vector<test_result> & a_results,
+                                      vector<option_zscore> & a_zscores,
+                                      vector<option_impact> & a_impacts);
+    };
+
+    //----------------------------------------------------------
+    // buffered event log
+    //      lines are appended to a memory buffer and written to the file by a
+    //      background thread, so that a slow disk never holds up testing
+    class event_log_writer
+    {
+        public:
+            // creation constructor; opens the file
+            event_log_writer(const string & a_file_name);
+
+            // destructor; writes anything still buffered
+            ~event_log_writer();
+
+            // queue a line (the newline is added)
+            void write(const string & a_line);
+
+        private:
+            // no copying
+            event_log_writer(const event_log_writer &);
+            event_log_writer & operator = (const event_log_writer &);
+
+            // background thread
+            static void * run_thread(void * a_writer);
+            void run();
+
+            // output file
+            FILE * m_file;
+
+            // lines waiting to be written, and the thread writing them; kept
+            //   in acovea.cpp, so that this header needs no thread library
+            struct writer_state;
+            writer_state * m_state;
+
+            // process that owns the writer (forked test processes don't log)
+            pid_t m_owner;
+    };
+
+    //----------------------------------------------------------
+    // JSON-lines listener
+    //      writes every event as a JSON object on its own line, for analysis
+    //      after a run, and passes each event on to another listener
+    class acovea_listener_json : public acovea_listener
+    {
+        public:
+            // creation constructor
+            acovea_listener_json(const string & a_file_name, acovea_listener & a_next);
+
+            // ping that a generation begins
+            virtual void ping_generation_begin(size_t a_generation_number);
+        
+            // ping that a generation ends
+            virtual void ping_generation_end(size_t a_generation_number);
+        
+            // ping that a population begins
+            virtual void ping_population_begin(size_t a_population_number);
+            
+            // ping that a population ends
+            virtual void ping_population_end(size_t a_population_number);
+            
+            // ping that a fitness test begins
+            virtual void ping_fitness_test_begin(size_t a_organism_number);
+            
+            // ping that a fitness test ends
+            virtual void ping_fitness_test_end(size_t a_organism_number);
+            
+            // send text
+            virtual void report(const string & a_text);
+            
+            // send error message
+            virtual void report_error(const string & a_text);
+            
+            // acovea is finished
+            virtual void run_complete();
+            
+            // yield
+            virtual void yield();
+            
+            // send configuration
+            virtual void report_config(const string & a_text);
+            
+            // send generation report (every generation)
+            virtual void report_generation(size_t a_gen_no, double a_avg_fitness);
+            
+            // send final report
+            virtual void report_final(vector<test_result> & a_results,
+                                      vector<option_zscore> & a_zscores,
+                                      vector<option_impact> & a_impacts);
+
+            // send population diversity and operator rates (every generation)
+            virtual void report_diversity(size_t a_gen_no,
+                                          const diversity & a_diversity,
+                                          double a_mutation_rate,
+                                          double a_crossover_rate);
+
+            // send the details of one compile-and-run test
+            virtual void report_evaluation(const evaluation_record & a_record);
+
+        private:
+            // start an event object with its name and time
+            string begin_event(const char * a_name) const;
+
+            // the log and the listener receiving the events as well
+            event_log_writer  m_log;
+            acovea_listener & m_next;
+
+            // time the log started
+            double m_start_time;
+
+            // current generation, and what its tests found
+            size_t m_generation;
+            size_t m_evaluations;
+            size_t m_cache_hits;
+            size_t m_failures;
+            double m_best_fitness;
+    };
+
+    //----------------------------------------------------------
+    // test counter
+    //      passes every event on to another listener, adding up the work
+    //      done by the tests it sees: a run at a reduced workload counts as
+    //      that fraction of a test, a result found in the cache counts as
+    //      nothing, and each of several inputs as its share of a test
+    class acovea_listener_counter : public acovea_listener
+    {
+        public:
+            // creation constructor
+            acovea_listener_counter(acovea_listener & a_next)
+              : m_next(a_next),
+                m_inputs(1),
+                m_tests(0.0)
+            {
+                // nada
+            }
+
+            // set the number of inputs tested for each option set
+            void set_inputs(size_t a_inputs)
+            {
+                m_inputs = (a_inputs > 0) ? a_inputs : 1;
+            }
+
+            // work done so far, in tests
+            double tests() const
+            {
+                return m_tests;
+            }
+
+            // events passed on
+            virtual void ping_generation_begin(size_t a_generation_number)
+            {
+                m_next.ping_generation_begin(a_generation_number);
+            }
+
+            virtual void ping_generation_end(size_t a_generation_number)
+            {
+                m_next.ping_generation_end(a_generation_number);
+            }
+
+            virtual void ping_population_begin(size_t a_population_number)
+            {
+                m_next.ping_population_begin(a_population_number);
+            }
+
+            virtual void ping_population_end(size_t a_population_number)
+            {
+                m_next.ping_population_end(a_population_number);
+            }
+
+            virtual void ping_fitness_test_begin(size_t a_organism_number)
+            {
+                m_next.ping_fitness_test_begin(a_organism_number);
+            }
+
+            virtual void ping_fitness_test_end(size_t a_organism_number)
+            {
+                m_next.ping_fitness_test_end(a_organism_number);
+            }
+
+            virtual void report(const string & a_text)
+            {
+                m_next.report(a_text);
+            }
+
+            virtual void report_error(const string & a_text)
+            {
+                m_next.report_error(a_text);
+            }
+
+            virtual void run_complete()
+            {
+                m_next.run_complete();
+            }
+
+            virtual void yield()
+            {
+                m_next.yield();
+            }
+
+            virtual void report_config(const string & a_text)
+            {
+                m_next.report_config(a_text);
+            }
+
+            virtual void report_generation(size_t a_gen_no, double a_avg_fitness)
+            {
+                m_next.report_generation(a_gen_no,a_avg_fitness);
+            }
+
+            virtual void report_final(vector<test_result> & a_results,
+                                      vector<option_zscore> & a_zscores,
+                                      vector<option_impact> & a_impacts)
+            {
+                m_next.report_final(a_results,a_zscores,a_impacts);
+            }
+
+            virtual void report_diversity(size_t a_gen_no,
+                                          const diversity & a_diversity,
+                                          double a_mutation_rate,
+                                          double a_crossover_rate)
+            {
+                m_next.report_diversity(a_gen_no,a_diversity,a_mutation_rate,a_crossover_rate);
+            }
+
+            // count a test, and pass it on; a record may cover several inputs
+            virtual void report_evaluation(const evaluation_record & a_record)
+            {
+                if (!a_record.m_cache_hit)
+                    m_tests += a_record.m_scale * static_cast<double>(a_record.m_inputs) / static_cast<double>(m_inputs);
+
+                m_next.report_evaluation(a_record);
+            }
+
+        private:
+            // the listener receiving the events
+            acovea_listener & m_next;
+
+            // inputs tested for each option set
+            size_t m_inputs;
+
+            // work done so far
+            double m_tests;
+    };
+
+    //----------------------------------------------------------
+    // binary fingerprint cache
+    //      different option sets often produce identical executables; the
+    //      cache maps a content hash of a compiled program to its measured
+    //      fitness, so that each distinct binary is benchmarked only until
+    //      it has the requested number of samples
+    class fitness_cache
+    {
+        public:
+            // creation constructor
+            fitness_cache(bool a_code_only = true, size_t a_refine_limit = 1);
+
+            // compute the fingerprint of a compiled program
+            uint64_t fingerprint(const string & a_file_name) const;
+
+            // retrieve the mean fitness of a binary, if it has enough samples
+            //   or has failed
+            bool lookup(uint64_t a_key, double & a_fitness);
+
+            // add a measurement for a binary
+            void record(uint64_t a_key, double a_fitness);
+
+            // interrogators
+            size_t hits() const
+            {
+                return m_hits;
+            }
+
+            size_t misses() const
+            {
+                return m_misses;
+            }
+
+            size_t size() const
+            {
+                return m_entries.size();
+            }
+
+            // text describing the cache for configuration reports
+            string get_description() const;
+
+            // hit rate for the current generation and the whole run
+            string get_stats_text() const;
+
+            // begin counting a new generation
+            void reset_generation_stats();
+
+            // write or read the cache contents to or from a checkpoint
+            void save(FILE * a_file) const;
+            void load(FILE * a_file);
+
+        private:
+            // accumulated measurements for one binary
+            typedef struct cache_entry
+            {
+                double m_total;     // BOGUS_RUN_TIME once any sample fails
+                size_t m_samples;
+            } cache_entry;
+
+            // measurements indexed by fingerprint
+            map<uint64_t, cache_entry> m_entries;
+
+            // fingerprint code sections only?
+            bool m_code_only;
+
+            // samples required before a measurement is reused
+            size_t m_refine_limit;
+
+            // statistics for the run and the current generation
+            size_t m_hits;
+            size_t m_misses;
+            size_t m_gen_hits;
+            size_t m_gen_misses;
+
+            // benchmark time avoided by cache hits
+            double m_saved;
+    };
+
+    //----------------------------------------------------------
+    // profile cache
+    //      for two-phase builds, an instrumented program is built and run
+    //      to train a profile that the final build uses; profiles are kept
+    //      per input and per setting of the options that affect
+    //      instrumentation, so that training isn't repeated for every
+    //      option set
+    class profile_cache
+    {
+        public:
+            // creation constructor
+            profile_cache(const application & a_target, acovea_listener & a_listener);
+
+            // destructor; removes the profiles
+            ~profile_cache();
+
+            // directory holding the profile for an input and option set,
+            //   trained if needed; empty if the profile can't be trained
+            string get_profile(const string & a_input_name, const chromosome & a_options);
+
+            // text describing the cache for configuration reports
+            string get_description() const;
+
+            // profiles trained and reused in the current generation
+            string get_stats_text() const;
+
+            // begin counting a new generation
+            void reset_generation_stats();
+
+        private:
+            // no copying
+            profile_cache(const profile_cache & a_source);
+            profile_cache & operator = (const profile_cache & a_source);
+
+            // build and run an instrumented program in a new directory
+            string train(const string & a_input_name, const chromosome & a_options);
+
+            // application object that is target of this test
+            const application & m_target;
+
+            // a listener to report errors
+            acovea_listener & m_listener;
+
+            // profile directories, indexed by input and instrumentation options
+            map<string,string> m_profiles;
+
+            // statistics for the run and the current generation
+            size_t m_trained;
+            size_t m_reused;
+            size_t m_gen_trained;
+            size_t m_gen_reused;
+
+            // process that owns the directories (forked test processes don't)
+            pid_t m_owner;
+    };
+
+    //----------------------------------------------------------
+    // run checkpoint
+    //      saves the state of a run in a compact binary file at the end of
+    //      a generation, and restores it; the random number generator is
+    //      reseeded from the run's seed after each generation, so that a
+    //      resumed run continues exactly as the original would have
+    class run_checkpoint : protected common
+    {
+        public:
+            // creation constructor
+            run_checkpoint(const application & a_target,
+                           const string &      a_file_name,
+                           size_t              a_every,
+                           double              a_minutes,
+                           fitness_cache *     a_cache,
+                           surrogate_model *   a_surrogate,
+                           diversity_controller * a_diversity,
+                           offspring_filter *  a_filter);
+
+            // is checkpointing active?
+            bool is_enabled() const
+            {
+                return !m_file_name.empty();
+            }
+
+            // load a saved run; returns the generation being resumed
+            size_t load(const string & a_file_name,
+                        size_t a_number_of_populations,
+                        size_t a_population_size);
+
+            // is the current generation a replay of a restored one?
+            bool is_replaying() const
+            {
+                return m_replaying;
+            }
+
+            // hand out the next restored population; false if there is none
+            bool restore_population(vector<acovea_organism> & a_population);
+
+            // option counts restored with the populations
+            const vector< vector<unsigned long> > & get_opt_counts() const
+            {
+                return m_opt_counts;
+            }
+
+            // the seed the run started with
+            uint32_t get_base_seed() const
+            {
+                return m_base_seed;
+            }
+
+            // end of a generation: reseed, and save if a checkpoint is due
+            void generation_complete(const vector< vector<acovea_organism> > & a_populations,
+                                     size_t a_generation,
+                                     const vector< vector<unsigned long> > & a_opt_counts);
+
+        private:
+            // write the state of the run
+            void save(const vector< vector<acovea_organism> > & a_populations,
+                      size_t a_generation,
+                      const vector< vector<unsigned long> > & a_opt_counts) const;
+
+            // application object that is target of this run
+            const application & m_target;
+
+            // checkpoint file name
+            string m_file_name;
+
+            // checkpoint interval
+            size_t m_every;
+            double m_minutes;
+            time_t m_last_save;
+
+            // state saved with the populations
+            fitness_cache *   m_cache;
+            surrogate_model * m_surrogate;
+            diversity_controller * m_diversity;
+            offspring_filter * m_filter;
+
+            // seed the run started with
+            uint32_t m_base_seed;
+
+            // restored state
+            bool m_replaying;
+            vector< vector<acovea_organism> > m_populations;
+            vector< vector<unsigned long> > m_opt_counts;
+    };
+
+    //----------------------------------------------------------
+    // fitness landscape
+    class acovea_landscape : public landscape< acovea_organism >,
+                             protected common
+    {
+        public:
+            // creation constructor
+            acovea_landscape(const benchmark_suite & a_suite,
+                             optimization_mode   a_mode,
+                             const application & a_target,
+                             acovea_listener &   a_listener,
+                             fitness_cache *     a_cache = NULL,
+                             surrogate_model *   a_surrogate = NULL,
+                             const run_checkpoint * a_checkpoint = NULL,
+                             fidelity_schedule * a_fidelity = NULL,
+                             profile_cache *     a_profiles = NULL);
+
+            // copy constructor
+            acovea_landscape(const acovea_landscape & a_source);
+
+            // destructor
+            ~acovea_landscape();
+
+            // assignment
+            acovea_landscape & operator = (const acovea_landscape & a_source);
+
+            // test a single option list
+            virtual double test(acovea_organism & a_org, bool a_verbose = false) const;
+
+            // test a population of option lists
+            virtual double test(vector< acovea_organism > & a_population) const;
+
+            // assign fitness from Pareto rank and crowding distance (NSGA-II)
+            static void assign_pareto_fitness(vector< acovea_organism > & a_population);
+
+        private:
+            // test an option list with a scaled workload
+            double test_scaled(acovea_organism & a_org, double a_scale) const;
+
+            // test a population through the rungs of the fidelity schedule
+            double test_rungs(vector< acovea_organism > & a_population) const;
+
+            // programs being tested
+            const benchmark_suite * m_suite;
+        
+            // testing mode
+            optimization_mode m_mode;
+
+            // application object that is target of this test
+            const application & m_target;
+
+            // shared binary fingerprint cache (NULL if disabled)
+            fitness_cache * m_cache;
+
+            // surrogate model trained on every measurement (NULL if disabled)
+            surrogate_model * m_surrogate;
+
+            // checkpoint that may be replaying a restored generation
+            const run_checkpoint * m_checkpoint;
+
+            // multi-fidelity screening (NULL if disabled)
+            fidelity_schedule * m_fidelity;
+
+            // profiles for two-phase builds (NULL if none)
+            profile_cache * m_profiles;
+
+            // listener receiving the details of each test
+            acovea_listener & m_events;
+    };
+    
+    //----------------------------------------------------------
+    // repeated measurement of an option set
+    typedef struct measurement
+    {
+        double m_mean;          // mean fitness (a huge value if any test failed)
+        double m_deviation;     // sample standard deviation
+        size_t m_samples;       // number of runs
+    } measurement;
+
+    //----------------------------------------------------------
+    // benchmark runner
+    //      runs a compiled benchmark for one sample at a time; as a fork
+    //      server, the benchmark initializes once, then forks a fresh copy
+    //      of itself for each sample on request over a pipe. A benchmark
+    //      that doesn't speak the protocol just runs, and is then executed
+    //      anew for each sample
+    class benchmark_runner
+    {
+        public:
+            // descriptors through which a benchmark serves (as in AFL)
+            static const int CONTROL_FD = 198;
+            static const int STATUS_FD  = 199;
+
+            // creation constructor
+            benchmark_runner(const string & a_program,
+                             listener & a_listener,
+                             bool a_fork_server = false,
+                             double a_scale = 1.0);
+
+            // destructor (stops any server)
+            ~benchmark_runner();
+
+            // run one sample, returning its output and wait status
+            void run(string & a_output, int & a_status);
+
+            // is the benchmark serving samples?
+            bool is_serving() const
+            {
+                return m_server != 0;
+            }
+
+        private:
+            // start the program, with its output on a pipe
+            pid_t launch(bool a_serve, int & a_output, int & a_control, int & a_status_pipe);
+
+            // run the program once, to completion
+            void execute(string & a_output, int & a_status);
+
+            // start a server; if the program doesn't answer, it ran once
+            bool start(string & a_output, int & a_status);
+
+            // have the server fork a sample; false if the server is gone
+            bool request(string & a_output, int & a_status);
+
+            // stop the server
+            void stop();
+
+            // no copying
+            benchmark_runner(const benchmark_runner &);
+            benchmark_runner & operator = (const benchmark_runner &);
+
+            string     m_program;
+            listener & m_listener;
+            bool       m_fork_server;   // try to start a server
+            double     m_scale;         // workload scale (1 for full)
+            pid_t      m_server;        // serving process (zero if none)
+            int        m_output;        // server's standard output
+            int        m_control;       // requests to the server
+            int        m_status;        // wait status of each sample
+    };
+
+    //----------------------------------------------------------
+    // parallel tester
+    //      compiles each option set once and runs it several times; up to
+    //      a given number of option sets are tested at once, each in its
+    //      own child process
+    class parallel_tester : protected common
+    {
+        public:
+            // creation constructor
+            parallel_tester(const benchmark_suite & a_suite,
+                            optimization_mode   a_mode,
+                            const application & a_target,
+                            acovea_listener &   a_listener,
+                            size_t              a_jobs,
+                            size_t              a_repeats,
+                            bool                a_fork_server = false);
+
+            // set the profiles for two-phase builds
+            void set_profiles(profile_cache * a_profiles)
+            {
+                m_profiles = a_profiles;
+            }
+
+            // measure a list of option sets
+            vector<measurement> measure(const vector<chromosome> & a_options) const;
+
+            // start measuring an option set in the background, identified by
+            //   a tag; returns false if every job is busy
+            bool start(const chromosome & a_options, size_t a_tag) const;
+
+            // collect a finished measurement, if there is one
+            bool collect(size_t & a_tag, measurement & a_result) const;
+
+            // number of measurements in progress
+            size_t running() const
+            {
+                return m_pids.size();
+            }
+
+            // interrogators
+            size_t jobs() const
+            {
+                return m_jobs;
+            }
+
+            size_t repeats() const
+            {
+                return m_repeats;
+            }
+
+            const application & target() const
+            {
+                return m_target;
+            }
+
+            // half-width of the 95% confidence interval of a mean
+            static double confidence(const measurement & a_measurement);
+
+            // is the first measurement better than the second, beyond noise
+            //   and by at least the given fraction?
+            static bool is_better(const measurement & a_first,
+                                  const measurement & a_second,
+                                  double a_threshold);
+
+        private:
+            // compile and run one option set (in a child process)
+            vector<double> sample(const chromosome & a_options, evaluation_record & a_record) const;
+
+            // compile and run one option set on one input
+            vector<double> sample_input(size_t a_input,
+                                        const chromosome & a_options,
+                                        evaluation_record & a_record) const;
+
+            // programs being tested
+            const benchmark_suite & m_suite;
+
+            // testing mode
+            optimization_mode m_mode;
+
             // application object that is target of this test
             const application & m_target;
+
+            // listener for errors, yields and test details
+            acovea_listener & m_listener;
+
+            // number of option sets tested at once
+            size_t m_jobs;
+
+            // runs per option set
+            size_t m_repeats;
+
+            // run repeats through a fork server
+            bool m_fork_server;
+
+            // profiles for two-phase builds (NULL if none)
+            profile_cache * m_profiles;
+
+            // measurements in progress
+            mutable vector<pid_t>  m_pids;
+            mutable vector<int>    m_pipes;
+            mutable vector<size_t> m_tags;
+            mutable vector<uint64_t> m_started;
+            mutable vector<size_t>   m_slots;
+            mutable vector<size_t>   m_tests;
     };
 
     //----------------------------------------------------------
-    // an object that watches acovea world events
-    typedef struct test_result
+    // option polisher
+    //      a first-improvement hill climb from an evolved option set, which
+    //      toggles each flag and nudges each tuning value, followed by the
+    //      removal of flags that make no measurable difference
+    class option_polisher : protected common
     {
-        string  m_description;
-        string  m_detail;
-        double  m_fitness;
-        bool    m_acovea_generated;
-    } test_result;
-    
-    typedef struct option_zscore
+        public:
+            // creation constructor
+            option_polisher(const parallel_tester & a_tester,
+                            listener &              a_listener,
+                            size_t                  a_passes,
+                            double                  a_threshold);
+
+            // improve and minimize an option set; the measurement of the
+            //   result is returned through a_result
+            chromosome polish(const chromosome & a_start, measurement & a_result) const;
+
+        private:
+            // every option set one step away from the given one
+            vector<chromosome> neighbors(const chromosome & a_options, vector<string> & a_moves) const;
+
+            // tester used for all measurements
+            const parallel_tester & m_tester;
+
+            // listener for progress reports
+            listener & m_listener;
+
+            // maximum improvement passes
+            size_t m_passes;
+
+            // smallest relative change in fitness considered real
+            double m_threshold;
+    };
+
+    //----------------------------------------------------------
+    // option ablation
+    //      measures the change in fitness when each enabled option is
+    //      removed from a final option set, and when each of a list of
+    //      promising options is added to it
+    class option_ablation : protected common
     {
-        string  m_name;
-        double  m_zscore;
-    } option_zscore;
-    
-    class acovea_listener : public libevocosm::listener
+        public:
+            // creation constructor
+            option_ablation(const parallel_tester & a_tester, listener & a_listener);
+
+            // measure the impact of options, ranked by size of effect
+            vector<option_impact> analyze(const chromosome & a_options,
+                                          const vector<string> & a_candidates) const;
+
+        private:
+            // tester used for all measurements
+            const parallel_tester & m_tester;
+
+            // listener for progress reports
+            listener & m_listener;
+    };
+
+    //----------------------------------------------------------
+    // migrant transport
+    //      carries organisms between cooperating ACOVEA processes; sending
+    //      and receiving never wait, so a slow island never stalls others
+    class migrant_transport
     {
         public:
-            // send configuration
-            virtual void report_config(const string & a_text) = 0;
-        
-            // send generation report (every generation)
-            virtual void report_generation(size_t a_gen_no, double a_avg_fitness) = 0;
-        
-            // send final report
-            virtual void report_final(vector<test_result> & a_results, vector<option_zscore> & a_zscores) = 0;
+            // send a message to every peer
+            virtual void send(const string & a_message) = 0;
+
+            // receive a waiting message, if there is one
+            virtual bool receive(string & a_message) = 0;
+
+            // description for configuration reports
+            virtual string get_description() const = 0;
+
+            // virtual destructor
+            virtual ~migrant_transport()
+            {
+                // nada
+            }
+
+            // create a transport from an address of the form
+            //   unix:{path} or udp:{host}:{port}
+            static migrant_transport * create(const string & a_address,
+                                              const vector<string> & a_peers);
     };
-    
-    class acovea_listener_stdout : public acovea_listener
+
+    //----------------------------------------------------------
+    // datagram transport over Unix domain or UDP sockets
+    class datagram_transport : public migrant_transport
     {
         public:
-            // ping that a generation begins
-            virtual void ping_generation_begin(size_t a_generation_number);
-        
-            // ping that a generation begins
-            virtual void ping_generation_end(size_t a_generation_number);
-        
-            // ping that a population begins
-            virtual void ping_population_begin(size_t a_population_number);
-            
-            // ping that a population begins
-            virtual void ping_population_end(size_t a_population_number);
-            
-            // ping that a fitness test begins
-            virtual void ping_fitness_test_begin(size_t a_organism_number);
-            
-            // ping that a fitness test begins
-            virtual void ping_fitness_test_end(size_t a_organism_number);
-            
-            // send text
-            virtual void report(const string & a_text);
-            
-            // send error message
-            virtual void report_error(const string & a_text);
-            
-            // acovea is finished
-            virtual void run_complete();
-            
-            // yield
-            virtual void yield();
-            
-            // send configuration
-            virtual void report_config(const string & a_text);
-            
-            // send generation report (every generation)
-            virtual void report_generation(size_t a_gen_no, double a_avg_fitness);
-            
-            // send final report
-            virtual void report_final(vector<test_result> & a_results, vector<option_zscore> & a_zscores);
+            // creation constructor
+            datagram_transport(const string & a_address, const vector<string> & a_peers);
+
+            // destructor
+            virtual ~datagram_transport();
+
+            // send a message to every peer
+            virtual void send(const string & a_message);
+
+            // receive a waiting message, if there is one
+            virtual bool receive(string & a_message);
+
+            // description for configuration reports
+            virtual string get_description() const;
+
+        private:
+            // no copying
+            datagram_transport(const datagram_transport & a_source);
+            datagram_transport & operator = (const datagram_transport & a_source);
+
+            // translate an address to a socket address; returns its length
+            static size_t resolve(const string & a_address, struct sockaddr_storage & a_result, int & a_family);
+
+            // our socket and address
+            int    m_socket;
+            string m_address;
+
+            // peer socket addresses
+            vector<struct sockaddr_storage> m_peers;
+            vector<size_t> m_peer_lengths;
     };
 
     //----------------------------------------------------------
-    // fitness landscape
-    class acovea_landscape : public landscape< acovea_organism >,
-                             protected common
+    // island migrator
+    //      migrates among this process's populations with a local migrator,
+    //      then sends copies of its best organisms to other processes and
+    //      replaces its worst organisms with any immigrants that have arrived
+    class island_migrator : public migrator< acovea_organism >, protected common
     {
         public:
             // creation constructor
-            acovea_landscape(string              a_bench_name,
-                             optimization_mode   a_mode,
-                             const application & a_target,
-                             acovea_listener &   a_listener);
+            island_migrator(migrator< acovea_organism > & a_local,
+                            migrant_transport & a_transport,
+                            const application & a_target,
+                            listener & a_listener,
+                            size_t a_how_many);
 
-            // copy constructor
-            acovea_landscape(const acovea_landscape & a_source);
+            // migrate organisms
+            virtual void migrate(vector< vector< acovea_organism > > & a_populations);
 
-            // destructor
-            ~acovea_landscape();
+        private:
+            // convert an organism to and from a message
+            string encode(const acovea_organism & a_org) const;
+            bool decode(const string & a_message, acovea_organism & a_org) const;
 
-            // assignment
-            acovea_landscape & operator = (const acovea_landscape & a_source);
+            // migrator for populations in this process
+            migrator< acovea_organism > & m_local;
 
-            // test a single option list
-            virtual double test(acovea_organism & a_org, bool a_verbose = false) const;
+            // connection to other processes
+            migrant_transport & m_transport;
 
-            // test a population of option lists
-            virtual double test(vector< acovea_organism > & a_population) const;
+            // application object that is target of this run
+            const application & m_target;
+
+            // listener for migration reports
+            listener & m_listener;
+
+            // number of organisms sent each generation
+            size_t m_how_many;
+
+            // identity of the configuration's options, sent with each migrant
+            uint64_t m_fingerprint;
+    };
+
+    //----------------------------------------------------------
+    // population seeder
+    //      starts part of each initial population from known option lists
+    //      rather than at random: the configuration's baselines, mapped onto
+    //      its options, or lists saved from earlier runs
+    class population_seeder
+    {
+        public:
+            // creation constructor
+            population_seeder(const application & a_target, double a_fraction, double a_mutation);
+
+            // add the baselines as seeds
+            void add_baselines();
+
+            // add seeds from a file, best first
+            void add_file(const string & a_file_name);
+
+            // set options matching a list of command-line flags; the rest
+            //   are disabled. Returns the number of flags matched.
+            size_t map_flags(const string & a_flags, chromosome & a_options);
+
+            // the flags for a list of options
+            static string get_flags(const chromosome & a_options);
+
+            // write populations to a file in the format read by add_file
+            static void save(const string & a_file_name,
+                             const vector< vector<acovea_organism> > & a_populations);
+
+            // start a population with seeds; returns the number of organisms added
+            size_t seed(vector<acovea_organism> & a_population, size_t a_size);
+
+            // description for configuration reports
+            string get_description() const;
 
         private:
-            // name of application for information display
-            string m_input_name;
-        
-            // testing mode
-            optimization_mode m_mode;
+            // add a seed unless an identical one is already there
+            void add_seed(const chromosome & a_options);
 
-            // application object that is target of this test
+            // application object that is target of this run
             const application & m_target;
+
+            // share of each population seeded
+            double m_fraction;
+
+            // mutation applied to a seed after its first use
+            double m_mutation;
+
+            // seeds, their flags, and the next one to use
+            vector<chromosome> m_seeds;
+            set<string> m_seed_flags;
+            size_t m_next;
+
+            // flags matched and seen, repeated seeds dropped, and baselines
+            //   that match no options, for the configuration report
+            size_t m_matched;
+            size_t m_flags;
+            size_t m_repeats;
+            vector<string> m_unmatched;
     };
-    
+
+    //----------------------------------------------------------
+    // run budget
+    //      decides when evolution should stop before its last generation:
+    //      after a number of tests, at a wall-clock deadline, on reaching a
+    //      target fitness, or when the best fitness stops improving; part of
+    //      the test and time limits is held back for the final report
+    class run_budget
+    {
+        public:
+            // creation constructor
+            run_budget(const run_settings & a_settings);
+
+            // is any limit set?
+            bool is_limited() const;
+
+            // does the budget need the baselines' fitness?
+            bool needs_baseline() const
+            {
+                return m_target_ratio > 0.0;
+            }
+
+            // set the fitness that the target is relative to
+            void set_baseline(double a_fitness);
+
+            // may a_count more tests be started, after a_evaluations tests?
+            //   if not, a_reason says why
+            bool allows(double a_evaluations, size_t a_count, string & a_reason) const;
+
+            // note the best fitness after a generation; returns true, with
+            //   a reason, if evolution should stop
+            bool is_finished(double a_best_fitness, string & a_reason);
+
+            // description for configuration reports
+            string get_description() const;
+
+        private:
+            // limits
+            size_t m_max_evaluations;
+            double m_max_minutes;
+            double m_target_ratio;
+            size_t m_stall_generations;
+            double m_stall_epsilon;
+            double m_reserve;
+
+            // when the run started
+            double m_start_time;
+
+            // fitness the target is relative to
+            double m_baseline;
+
+            // best fitness seen, and generations since it last improved
+            double m_best;
+            size_t m_stalled;
+    };
+
     //----------------------------------------------------------
     // status and statistics
     class acovea_reporter : public reporter<acovea_organism,acovea_landscape>,
@@ -736,7 +2747,7 @@ namespace acovea
     {
         public:
             // creation constructor
-            acovea_reporter(string              a_bench_name,
+            acovea_reporter(const benchmark_suite & a_suite,
                             size_t              a_number_of_populations,
                             const application & a_target,
                             acovea_listener &   a_listener,
@@ -751,6 +2762,97 @@ namespace acovea
                 m_config_text = a_config_text;
             }
 
+            // set the binary fingerprint cache to be reported
+            void set_fitness_cache(fitness_cache * a_cache)
+            {
+                m_cache = a_cache;
+            }
+
+            // set the surrogate model whose accuracy is reported
+            void set_surrogate(surrogate_model * a_surrogate)
+            {
+                m_surrogate = a_surrogate;
+            }
+
+            // set the polisher applied to the best organism at the end
+            void set_polisher(const option_polisher * a_polisher)
+            {
+                m_polisher = a_polisher;
+            }
+
+            // set the ablation applied to the final options
+            void set_ablation(const option_ablation * a_ablation)
+            {
+                m_ablation = a_ablation;
+            }
+
+            // set the diversity controller run after each generation
+            void set_diversity(diversity_controller * a_diversity)
+            {
+                m_diversity = a_diversity;
+            }
+
+            // set the duplicate filter to be reported
+            void set_offspring_filter(offspring_filter * a_filter)
+            {
+                m_filter = a_filter;
+            }
+
+            // set the multi-fidelity schedule to be reported
+            void set_fidelity(fidelity_schedule * a_fidelity)
+            {
+                m_fidelity = a_fidelity;
+            }
+
+            // set the profiles for two-phase builds, to be used and reported
+            void set_profiles(profile_cache * a_profiles)
+            {
+                m_profiles = a_profiles;
+            }
+
+            // set a file to receive the final populations as seeds
+            void set_seed_output(const string & a_file_name)
+            {
+                m_seed_output = a_file_name;
+            }
+
+            // report phase timing, and write it to a file (if named)
+            void set_timing(bool a_report, const string & a_file_name)
+            {
+                m_report_timing = a_report;
+                m_timing_file   = a_file_name;
+            }
+
+            // set the checkpoint notified after each generation; a restored
+            //   run continues counting from a_first_generation
+            void set_checkpoint(run_checkpoint * a_checkpoint, size_t a_first_generation = 1);
+
+            // set the counter of fitness tests, for reporting throughput
+            void set_test_counter(const acovea_listener_counter * a_counter)
+            {
+                m_counter = a_counter;
+            }
+
+            // work done by fitness tests so far
+            double evaluations() const
+            {
+                return (m_counter != NULL) ? m_counter->tests() : 0.0;
+            }
+
+            // best fitness reported so far
+            double best_fitness() const
+            {
+                return m_best_fitness;
+            }
+
+            // report final results for a run that stopped before its last
+            //   generation, from the last populations reported
+            void finish();
+
+            // report where a generation's time went, once its children are
+            //   bred; a generation's report closes it only if it is the last
+            void end_generation();
+
             // report status and statistics
             virtual bool report(const vector< vector< acovea_organism > > & a_populations,
                                 size_t   a_iteration,
@@ -760,7 +2862,7 @@ namespace acovea
         private:
             // constants for display and loops
             const size_t m_number_of_populations;
-            const string m_input_name;
+            const benchmark_suite & m_suite;
             string m_config_text;
             
             // the threshold for reporting an option as optimistic or pessimistic
@@ -775,6 +2877,15 @@ namespace acovea
             // accumulate_stats
             void accumulate_stats(const chromosome & a_options, int a_pop_no);
 
+            // report final results
+            void report_results(const vector< vector< acovea_organism > > & a_populations);
+
+            // results on each input, when a suite combines several
+            vector<input_result> get_input_results(const vector<evaluation_record> & a_records) const;
+
+            // options of each separately tuned function
+            vector< pair<string,string> > get_function_results(const chromosome & a_options) const;
+
             // application object that is target of this test
             const application & m_target;
             
@@ -783,6 +2894,54 @@ namespace acovea
         
             // testing mode
             optimization_mode m_mode;
+
+            // binary fingerprint cache (NULL if disabled)
+            fitness_cache * m_cache;
+
+            // surrogate fitness model (NULL if disabled)
+            surrogate_model * m_surrogate;
+
+            // final local search (NULL if disabled)
+            const option_polisher * m_polisher;
+
+            // final measurement of option impacts (NULL if disabled)
+            const option_ablation * m_ablation;
+
+            // checkpoint (NULL if disabled)
+            run_checkpoint * m_checkpoint;
+
+            // diversity tracking and rate control (NULL if disabled)
+            diversity_controller * m_diversity;
+
+            // duplicate offspring filter (NULL if disabled)
+            offspring_filter * m_filter;
+
+            // multi-fidelity schedule (NULL if disabled)
+            fidelity_schedule * m_fidelity;
+
+            // profiles for two-phase builds
+            profile_cache * m_profiles;
+
+            // file receiving the final populations (empty if none)
+            string m_seed_output;
+
+            // phase timing reports, and the file receiving the histograms
+            bool   m_report_timing;
+            string m_timing_file;
+            bool   m_timing_replayed;   // the open generation was restored, not tested
+
+            // generation number of the first generation this reporter sees
+            size_t m_first_generation;
+
+            // counter of fitness tests (NULL if not counted)
+            const acovea_listener_counter * m_counter;
+            double m_start_time;
+
+            // best fitness reported so far
+            double m_best_fitness;
+
+            // populations from the most recent report
+            vector< vector< acovea_organism > > m_last_populations;
     };
     
     //----------------------------------------------------------
@@ -804,7 +2963,8 @@ namespace acovea
                          double a_mutation_rate,
                          double a_crossover_rate,
                          bool   a_use_scaling,
-                         size_t a_generations);
+                         size_t a_generations,
+                         const run_settings & a_settings = run_settings());
 
             // destructor
             virtual ~acovea_world();
@@ -824,9 +2984,27 @@ namespace acovea
             void terminate();
 
         private:
+            // run with steady-state rather than generational evolution
+            double run_steady_state();
+
+            // breed and mutate one child from a population
+            acovea_organism breed_one(const vector<acovea_organism> & a_population);
+
+            // test the baselines, returning the best fitness
+            double test_baselines();
+
             // number of iterations to run
             const size_t m_generations;
-            const string m_input_name;
+
+            // counts the tests reported to the listener, for the budget
+            acovea_listener_counter m_counter;
+
+            // programs being tested (baselines are set before the first generation)
+            benchmark_suite m_suite;
+
+            // shape of the populations
+            const size_t m_number_of_populations;
+            const size_t m_population_size;
 
             // create objects that define this population
             acovea_mutator                          m_mutator;
@@ -848,6 +3026,57 @@ namespace acovea
             
             // optimization mode
             optimization_mode m_mode;
+
+            // extended run settings
+            run_settings m_settings;
+
+            // binary fingerprint cache
+            fitness_cache m_cache;
+
+            // surrogate fitness model
+            surrogate_model m_surrogate;
+
+            // diversity tracking and rate control
+            diversity_controller m_diversity;
+
+            // duplicate offspring filter
+            offspring_filter m_filter;
+
+            // multi-fidelity screening of each generation
+            fidelity_schedule m_fidelity;
+
+            // profiles for two-phase builds
+            profile_cache m_profiles;
+
+            // initial population seeds
+            population_seeder m_seeder;
+
+            // repeated, parallel measurements outside the generational loop
+            parallel_tester m_tester;
+
+            // final local search
+            option_polisher m_polisher;
+
+            // final measurement of option impacts
+            option_ablation m_ablation;
+
+            // saving and restoring the state of the run
+            run_checkpoint m_checkpoint;
+
+            // generation at which this run starts (greater than one if resumed)
+            size_t m_first_generation;
+
+            // connection to other islands (NULL for a single process run)
+            migrant_transport * m_transport;
+
+            // migrator exchanging organisms with other islands
+            island_migrator * m_island_migrator;
+
+            // set when a steady-state run is asked to stop
+            bool m_terminated;
+
+            // limits on the length of the run
+            run_budget m_budget;
             
             // a string stream to hold the configuration text
             ostringstream m_config_text;